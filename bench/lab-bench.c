@@ -0,0 +1,733 @@
+/**
+ * @file lab-bench.c
+ * @brief Benchmarks for the list backends. Build and run with `make bench`;
+ * pass an element count as the first argument to change the list size, or
+ * `--alloc` to run only the allocator microbenchmarks (see `make bench-alloc`).
+ */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../src/lab.h"
+
+#define DEFAULT_ELEMENTS 100000u
+#define RANDOM_OPS 2000u
+// Above this size the random-access columns are skipped for backends whose
+// indexed access walks the list, since a single pass would take minutes.
+#define WALK_LIMIT 1000000u
+
+// --- Counting allocator passed to list_create_with_allocator ---
+// Each block carries its size in a header so frees can be subtracted again.
+// It is a per-list allocator rather than a lab hook so it also works when the
+// bench is built with ALLOCATOR=static.
+typedef union {
+    size_t size;
+    max_align_t align;
+} BlockHeader;
+
+typedef struct {
+    size_t live_bytes;
+    size_t live_blocks;
+} CountingCtx;
+
+static void *count_alloc(void *ctx, size_t size) {
+    CountingCtx *c = ctx;
+    BlockHeader *h = malloc(sizeof(BlockHeader) + size);
+    if (!h) return NULL;
+    h->size = size;
+    c->live_bytes += size;
+    c->live_blocks++;
+    return h + 1;
+}
+
+static void count_free(void *ctx, void *ptr) {
+    CountingCtx *c = ctx;
+    if (!ptr) return;
+    BlockHeader *h = (BlockHeader *)ptr - 1;
+    c->live_bytes -= h->size;
+    c->live_blocks--;
+    free(h);
+}
+
+typedef struct {
+    ListType type;
+    const char *name;
+    bool walks;     // indexed access is O(n)
+} BenchType;
+
+static const BenchType bench_types[] = {
+    { LIST_LINKED_SENTINEL, "sentinel", true },
+    { LIST_ARRAY,           "array",    false },
+    { LIST_UNROLLED,        "unrolled", true },
+    { LIST_TREE,            "tree",     false },
+    { LIST_SKIP,            "skip",     false },
+    { LIST_RING,            "ring",     false },
+    { LIST_BTREE,           "btree",    false },
+    { LIST_GAP,             "gap",      false },
+    { LIST_TIERED,          "tiered",   false },
+    { LIST_ADAPTIVE,        "adaptive", false },
+};
+#define BENCH_TYPES_COUNT (sizeof(bench_types) / sizeof(bench_types[0]))
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static unsigned long long bench_rng = 88172645463325252ull;
+
+static size_t bench_rand(size_t bound) {
+    bench_rng ^= bench_rng << 13;
+    bench_rng ^= bench_rng >> 7;
+    bench_rng ^= bench_rng << 17;
+    return (size_t)(bench_rng % bound);
+}
+
+/**
+ * Appends 1..n to list; destroys it and returns NULL on failure.
+ */
+static List *fill_list(List *list, size_t n) {
+    if (!list) return NULL;
+    for (size_t i = 0; i < n; ++i) {
+        if (!list_append(list, (void *)(i + 1))) {
+            list_destroy(list, NULL);
+            return NULL;
+        }
+    }
+    return list;
+}
+
+static List *filled_list_with(ListType type, size_t n, const ListOptions *options) {
+    return fill_list(list_create_with_options(type, options), n);
+}
+
+static List *filled_list(ListType type, size_t n) {
+    return filled_list_with(type, n, NULL);
+}
+
+/**
+ * Live heap bytes requested by each backend after n appends (allocator
+ * headers excluded), and the per-element cost beyond the 8-byte data pointer.
+ */
+static void bench_memory(size_t n) {
+    printf("\n== Memory overhead, %zu elements ==\n", n);
+    printf("%-10s %14s %10s %12s %12s\n", "type", "bytes", "blocks", "bytes/elem", "overhead");
+    for (size_t t = 0; t < BENCH_TYPES_COUNT; ++t) {
+        CountingCtx counts = { 0 };
+        ListAllocator allocator = { count_alloc, count_free, &counts };
+        List *list = fill_list(list_create_with_allocator(bench_types[t].type, &allocator), n);
+        if (list) {
+            double per_elem = (double)counts.live_bytes / (double)n;
+            printf("%-10s %14zu %10zu %12.2f %11.2fx\n", bench_types[t].name, counts.live_bytes,
+                   counts.live_blocks, per_elem, per_elem / (double)sizeof(void *));
+            list_destroy(list, NULL);
+        }
+    }
+}
+
+/**
+ * Wall time for n appends, then RANDOM_OPS random gets and RANDOM_OPS
+ * random insert/remove pairs on the full list.
+ */
+static void bench_operations(size_t n) {
+    printf("\n== Operation cost, %zu elements ==\n", n);
+    printf("%-10s %14s %14s %16s\n", "type", "append ns/op", "get ns/op", "ins+rem ns/op");
+    for (size_t t = 0; t < BENCH_TYPES_COUNT; ++t) {
+        double start = now_sec();
+        List *list = filled_list(bench_types[t].type, n);
+        double append_s = now_sec() - start;
+        if (!list) continue;
+        if (bench_types[t].walks && n > WALK_LIMIT) {
+            printf("%-10s %14.1f %14s %16s\n", bench_types[t].name, append_s * 1e9 / (double)n,
+                   "skipped", "skipped");
+            list_destroy(list, NULL);
+            continue;
+        }
+
+        size_t sink = 0;
+        start = now_sec();
+        for (size_t i = 0; i < RANDOM_OPS; ++i) {
+            sink += (size_t)list_get(list, bench_rand(n));
+        }
+        double get_s = now_sec() - start;
+
+        start = now_sec();
+        for (size_t i = 0; i < RANDOM_OPS; ++i) {
+            size_t idx = bench_rand(n);
+            list_insert(list, idx, (void *)idx);
+            sink += (size_t)list_remove(list, bench_rand(n + 1));
+        }
+        double edit_s = now_sec() - start;
+
+        printf("%-10s %14.1f %14.1f %16.1f\n", bench_types[t].name, append_s * 1e9 / (double)n,
+               get_s * 1e9 / RANDOM_OPS, edit_s * 1e9 / RANDOM_OPS);
+        if (sink == 42) putchar(' '); // keep the reads observable
+        list_destroy(list, NULL);
+    }
+}
+
+/**
+ * Queue-shaped traffic on a list holding n elements: RANDOM_OPS rounds of
+ * append at the tail plus remove at index 0.
+ */
+static void bench_queue(size_t n) {
+    printf("\n== Queue push+pop, %zu elements ==\n", n);
+    printf("%-10s %14s\n", "type", "ns/round");
+    for (size_t t = 0; t < BENCH_TYPES_COUNT; ++t) {
+        List *list = filled_list(bench_types[t].type, n);
+        if (!list) continue;
+        size_t sink = 0;
+        double start = now_sec();
+        for (size_t i = 0; i < RANDOM_OPS; ++i) {
+            list_append(list, (void *)i);
+            sink += (size_t)list_remove(list, 0);
+        }
+        double queue_s = now_sec() - start;
+        printf("%-10s %14.1f\n", bench_types[t].name, queue_s * 1e9 / RANDOM_OPS);
+        if (sink == 42) putchar(' ');
+        list_destroy(list, NULL);
+    }
+}
+
+/**
+ * Editor-cursor traffic: RANDOM_OPS inserts or removes at a cursor that
+ * drifts by at most two positions between edits, starting mid-list.
+ */
+static void bench_clustered(size_t n) {
+    printf("\n== Clustered edits, %zu elements ==\n", n);
+    printf("%-10s %14s\n", "type", "ns/edit");
+    for (size_t t = 0; t < BENCH_TYPES_COUNT; ++t) {
+        if (bench_types[t].walks && n > WALK_LIMIT) {
+            printf("%-10s %14s\n", bench_types[t].name, "skipped");
+            continue;
+        }
+        List *list = filled_list(bench_types[t].type, n);
+        if (!list) continue;
+        size_t cursor = n / 2;
+        size_t sink = 0;
+        double start = now_sec();
+        for (size_t i = 0; i < RANDOM_OPS; ++i) {
+            size_t r = bench_rand(8);
+            if (r < 5) {
+                list_insert(list, cursor, (void *)i);
+            } else {
+                sink += (size_t)list_remove(list, cursor);
+            }
+            cursor = cursor + r % 5 >= 2 ? cursor + r % 5 - 2 : 0;
+            if (cursor > list_size(list)) cursor = list_size(list);
+        }
+        double edit_s = now_sec() - start;
+        printf("%-10s %14.1f\n", bench_types[t].name, edit_s * 1e9 / RANDOM_OPS);
+        if (sink == 42) putchar(' ');
+        list_destroy(list, NULL);
+    }
+}
+
+/**
+ * Build and list_destroy time for n appends with the default allocator and
+ * with 1 MiB arena chunks (ListOptions::arena_chunk), where teardown only
+ * releases the chunks.
+ */
+static void bench_teardown(size_t n) {
+    ListOptions arena = { .arena_chunk = 1u << 20 };
+    printf("\n== Build and teardown, %zu elements ==\n", n);
+    printf("%-10s %14s %14s %14s %14s\n", "type", "build ms", "destroy ms", "arena build", "arena destroy");
+    for (size_t t = 0; t < BENCH_TYPES_COUNT; ++t) {
+        double ms[4];
+        for (int mode = 0; mode < 2; ++mode) {
+            double start = now_sec();
+            List *list = filled_list_with(bench_types[t].type, n, mode ? &arena : NULL);
+            double mid = now_sec();
+            list_destroy(list, NULL);
+            ms[2 * mode] = (mid - start) * 1e3;
+            ms[2 * mode + 1] = (now_sec() - mid) * 1e3;
+        }
+        printf("%-10s %14.2f %14.2f %14.2f %14.2f\n", bench_types[t].name, ms[0], ms[1], ms[2], ms[3]);
+    }
+}
+
+// --- Sentinel index seeks ---
+/**
+ * ns per list_get on a sentinel list for access patterns the finger and
+ * nearest-end seeks are meant for, against uniformly random indices.
+ */
+static void bench_seek(size_t n) {
+    List *list = filled_list(LIST_LINKED_SENTINEL, n);
+    if (!list) return;
+    printf("\n== Sentinel list_get patterns, %zu elements ==\n", n);
+    printf("%-14s %14s\n", "pattern", "ns/get");
+    size_t sink = 0;
+
+    double start = now_sec();
+    for (size_t i = 0; i < n; ++i) sink += (size_t)list_get(list, i);
+    printf("%-14s %14.2f\n", "forward", (now_sec() - start) * 1e9 / (double)n);
+
+    start = now_sec();
+    for (size_t i = n; i-- > 0;) sink += (size_t)list_get(list, i);
+    printf("%-14s %14.2f\n", "backward", (now_sec() - start) * 1e9 / (double)n);
+
+    size_t pos = n / 2;
+    start = now_sec();
+    for (size_t i = 0; i < n; ++i) {
+        pos = (pos + bench_rand(9) + n - 4) % n; // within 4 of the last index
+        sink += (size_t)list_get(list, pos);
+    }
+    printf("%-14s %14.2f\n", "near", (now_sec() - start) * 1e9 / (double)n);
+
+    start = now_sec();
+    for (size_t i = 0; i < RANDOM_OPS; ++i) sink += (size_t)list_get(list, bench_rand(n));
+    printf("%-14s %14.2f\n", "random", (now_sec() - start) * 1e9 / RANDOM_OPS);
+
+    if (sink == 42) putchar(' ');
+    list_destroy(list, NULL);
+}
+
+// --- Sparse seek index ---
+/**
+ * Random list_get on a sentinel list without and with list_enable_index, and
+ * the same with a random insert before every get, which invalidates the
+ * checkpoints past the insert and makes the next far seek rebuild them.
+ */
+static void bench_index(size_t n) {
+    size_t root = 1;
+    while (root * root < n) root++;
+    const size_t strides[] = { 0, 64, root };
+    printf("\n== Sentinel sparse index, %zu elements ==\n", n);
+    printf("%-10s %14s %16s %14s\n", "stride", "ns/get", "ns/insert+get", "index KiB");
+    for (size_t c = 0; c < sizeof(strides) / sizeof(strides[0]); ++c) {
+        List *list = filled_list(LIST_LINKED_SENTINEL, n);
+        if (!list) return;
+        ListMemStats plain, indexed;
+        list_memory_stats(list, &plain);
+        if (strides[c]) list_enable_index(list, strides[c]);
+        size_t sink = 0;
+
+        double start = now_sec();
+        for (size_t i = 0; i < RANDOM_OPS; ++i) sink += (size_t)list_get(list, bench_rand(n));
+        double get_ns = (now_sec() - start) * 1e9 / RANDOM_OPS;
+        size_t index_kib = list_memory_stats(list, &indexed) ? (indexed.bytes - plain.bytes) / 1024 : 0;
+
+        start = now_sec();
+        for (size_t i = 0; i < RANDOM_OPS; ++i) {
+            list_insert(list, bench_rand(list_size(list)), (void *)1);
+            sink += (size_t)list_get(list, bench_rand(list_size(list)));
+        }
+        double mixed_ns = (now_sec() - start) * 1e9 / RANDOM_OPS;
+
+        char label[16];
+        snprintf(label, sizeof(label), strides[c] ? "%zu" : "off", strides[c]);
+        printf("%-10s %14.1f %16.1f %14zu\n", label, get_ns, mixed_ns, index_kib);
+        if (sink == 42) putchar(' ');
+        list_destroy(list, NULL);
+    }
+}
+
+// --- Batched gets ---
+/**
+ * RANDOM_OPS scattered indices read with a list_get loop and with one
+ * list_get_many call. Walking backends skip the loop above WALK_LIMIT.
+ */
+static void bench_get_many(size_t n) {
+    size_t *idx = malloc(RANDOM_OPS * sizeof(size_t));
+    void **out = malloc(RANDOM_OPS * sizeof(void *));
+    if (!idx || !out) {
+        free(idx);
+        free(out);
+        return;
+    }
+    for (size_t i = 0; i < RANDOM_OPS; ++i) idx[i] = bench_rand(n);
+    printf("\n== Batched gets, %u scattered indices into %zu elements ==\n", RANDOM_OPS, n);
+    printf("%-10s %14s %14s\n", "type", "get loop ms", "get_many ms");
+    for (size_t t = 0; t < BENCH_TYPES_COUNT; ++t) {
+        List *list = filled_list(bench_types[t].type, n);
+        if (!list) continue;
+        size_t sink = 0;
+        double loop_ms = -1.0;
+        if (!bench_types[t].walks || n <= WALK_LIMIT) {
+            double start = now_sec();
+            for (size_t i = 0; i < RANDOM_OPS; ++i) sink += (size_t)list_get(list, idx[i]);
+            loop_ms = (now_sec() - start) * 1e3;
+        }
+        double start = now_sec();
+        if (list_get_many(list, idx, RANDOM_OPS, out)) sink += (size_t)out[RANDOM_OPS - 1];
+        double many_ms = (now_sec() - start) * 1e3;
+        if (loop_ms < 0) {
+            printf("%-10s %14s %14.3f\n", bench_types[t].name, "-", many_ms);
+        } else {
+            printf("%-10s %14.3f %14.3f\n", bench_types[t].name, loop_ms, many_ms);
+        }
+        if (sink == 42) putchar(' ');
+        list_destroy(list, NULL);
+    }
+    free(idx);
+    free(out);
+}
+
+// --- Bulk traversal ---
+// Full index loops on walking backends are quadratic, so they are only timed
+// up to this size.
+#define SCAN_WALK_LIMIT 100000u
+
+static bool sum_visit(void *data, void *ctx) {
+    *(size_t *)ctx += (size_t)data;
+    return true;
+}
+
+static void *sum_reduce(void *acc, void *data, void *ctx) {
+    (void)ctx;
+    return (void *)((size_t)acc + (size_t)data);
+}
+
+static void *identity_map(void *data, void *ctx) {
+    (void)ctx;
+    return data;
+}
+
+/**
+ * ns per element for one full pass: a list_get index loop, a ListIter loop,
+ * list_foreach, list_reduce and list_map_inplace.
+ */
+static void bench_bulk(size_t n) {
+    printf("\n== Bulk traversal, %zu elements (ns/element) ==\n", n);
+    printf("%-10s %12s %12s %12s %12s %12s\n", "type", "get loop", "iter", "foreach", "reduce", "map");
+    for (size_t t = 0; t < BENCH_TYPES_COUNT; ++t) {
+        List *list = filled_list(bench_types[t].type, n);
+        if (!list) continue;
+        double per = 1e9 / (double)n;
+        size_t sink = 0;
+        double loop_ns = -1.0;
+        if (!bench_types[t].walks || n <= SCAN_WALK_LIMIT) {
+            double start = now_sec();
+            for (size_t i = 0; i < n; ++i) sink += (size_t)list_get(list, i);
+            loop_ns = (now_sec() - start) * per;
+        }
+        double start = now_sec();
+        ListIter it;
+        for (bool ok = list_iter_begin(list, &it); ok; ok = list_iter_next(&it)) {
+            sink += (size_t)list_iter_get(&it);
+        }
+        double iter_ns = (now_sec() - start) * per;
+
+        start = now_sec();
+        list_foreach(list, sum_visit, &sink);
+        double foreach_ns = (now_sec() - start) * per;
+
+        start = now_sec();
+        sink += (size_t)list_reduce(list, sum_reduce, NULL, NULL);
+        double reduce_ns = (now_sec() - start) * per;
+
+        start = now_sec();
+        list_map_inplace(list, identity_map, NULL);
+        double map_ns = (now_sec() - start) * per;
+
+        if (loop_ns < 0) {
+            printf("%-10s %12s", bench_types[t].name, "-");
+        } else {
+            printf("%-10s %12.2f", bench_types[t].name, loop_ns);
+        }
+        printf(" %12.2f %12.2f %12.2f %12.2f\n", iter_ns, foreach_ns, reduce_ns, map_ns);
+        if (sink == 42) putchar(' ');
+        list_destroy(list, NULL);
+    }
+}
+
+// --- Node compaction ---
+#define NOISE_BLOCKS 4096u
+#define TRAVERSE_NODES 20000000u
+
+/**
+ * ns per node for full front-to-back walks with a ListIter.
+ */
+static double traverse_ns(List *list) {
+    size_t n = list_size(list);
+    size_t passes = TRAVERSE_NODES / n + 1;
+    size_t sink = 0;
+    double start = now_sec();
+    for (size_t p = 0; p < passes; ++p) {
+        ListIter it;
+        for (bool ok = list_iter_begin(list, &it); ok; ok = list_iter_next(&it)) {
+            sink += (size_t)list_iter_get(&it);
+        }
+    }
+    double elapsed = now_sec() - start;
+    if (sink == 42) putchar(' ');
+    return elapsed * 1e9 / ((double)passes * (double)n);
+}
+
+/**
+ * Traversal before and after list_compact on a sentinel list whose nodes
+ * were malloc'd one at a time between randomly sized, randomly replaced
+ * blocks, which scatters them across the heap the way long-lived churn does.
+ */
+static void bench_compact(size_t n) {
+    ListOptions per_node = { .slab_nodes = 1 };
+    List *list = list_create_with_options(LIST_LINKED_SENTINEL, &per_node);
+    if (!list) return;
+    void **noise = calloc(NOISE_BLOCKS, sizeof(void *));
+    if (!noise) {
+        list_destroy(list, NULL);
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        size_t k = bench_rand(NOISE_BLOCKS);
+        free(noise[k]);
+        noise[k] = malloc(16 + bench_rand(1024));
+        list_append(list, (void *)(i + 1));
+    }
+    for (size_t k = 0; k < NOISE_BLOCKS; ++k) {
+        free(noise[k]);
+    }
+    free(noise);
+
+    printf("\n== Sentinel traversal, %zu elements ==\n", n);
+    printf("%-12s %14s\n", "layout", "ns/node");
+    printf("%-12s %14.2f\n", "scattered", traverse_ns(list));
+    if (list_compact(list)) {
+        printf("%-12s %14.2f\n", "compacted", traverse_ns(list));
+    }
+    list_destroy(list, NULL);
+}
+
+// --- mmap region pools ---
+/**
+ * Resident set size in KiB from /proc/self/statm, or 0 where unavailable.
+ */
+static size_t rss_kib(void) {
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    size_t pages = 0, resident = 0;
+    if (fscanf(f, "%zu %zu", &pages, &resident) != 2) resident = 0;
+    fclose(f);
+    long page = sysconf(_SC_PAGESIZE);
+    return resident * (page > 0 ? (size_t)page / 1024 : 4);
+}
+
+/**
+ * Sentinel list traversal with nodes from malloc'd slabs versus an mmap
+ * region pool with and without transparent huge pages, plus RSS while the
+ * list is alive and after list_destroy (regions are MADV_DONTNEED'd).
+ */
+static void bench_regions(size_t n) {
+    printf("\n== Region-backed sentinel lists, %zu elements ==\n", n);
+    printf("%-12s %14s %14s %14s\n", "allocator", "ns/node", "RSS +KiB", "after destroy");
+    for (int mode = 0; mode < 3; ++mode) {
+        ListRegionPool *pool = NULL;
+        ListAllocator allocator;
+        if (mode > 0) {
+            pool = list_region_pool_create(0, mode == 2);
+            if (!pool) continue;
+            allocator = list_region_allocator(pool);
+        }
+        size_t base = rss_kib();
+        List *list = list_create_with_allocator(LIST_LINKED_SENTINEL, pool ? &allocator : NULL);
+        for (size_t i = 0; list && i < n; ++i) {
+            list_append(list, (void *)(i + 1));
+        }
+        if (list) {
+            double ns = traverse_ns(list);
+            size_t live = rss_kib() - base;
+            list_destroy(list, NULL);
+            size_t after = rss_kib();
+            printf("%-12s %14.2f %14zu %14zd\n", mode == 0 ? "malloc" : mode == 1 ? "regions" : "regions+THP",
+                   ns, live, (ptrdiff_t)after - (ptrdiff_t)base);
+        }
+        list_region_pool_destroy(pool);
+    }
+}
+
+// --- Thread scaling of node allocation ---
+#define THREAD_ROUNDS 50u
+#define THREAD_NODES 2000u
+#define GROW_NODES 200000u
+#define MAX_THREADS 32
+
+typedef struct {
+    const char *name;
+    ListOptions options;
+} NodeSourceCase;
+
+static const NodeSourceCase node_cases[] = {
+    { "node/malloc", { .slab_nodes = 1, .node_source = LIST_NODES_SLAB } },
+    { "slab", { .node_source = LIST_NODES_SLAB } },
+    { "thread cache", { .node_source = LIST_NODES_THREAD_CACHE } },
+};
+#define NODE_CASES_COUNT (sizeof(node_cases) / sizeof(node_cases[0]))
+
+/**
+ * One worker: THREAD_ROUNDS short-lived sentinel lists, each filled with
+ * THREAD_NODES appends, drained by half from the head and destroyed.
+ */
+static void *thread_worker(void *arg) {
+    const ListOptions *options = arg;
+    size_t sink = 0;
+    for (size_t r = 0; r < THREAD_ROUNDS; ++r) {
+        List *list = list_create_with_options(LIST_LINKED_SENTINEL, options);
+        if (!list) return NULL;
+        for (size_t i = 0; i < THREAD_NODES; ++i) {
+            list_append(list, (void *)(i + 1));
+        }
+        for (size_t i = 0; i < THREAD_NODES / 2; ++i) {
+            sink += (size_t)list_remove(list, 0);
+        }
+        list_destroy(list, NULL);
+    }
+    return (void *)sink;
+}
+
+typedef struct {
+    const ListOptions *options;
+    double start;
+    double end;
+} GrowTask;
+
+/**
+ * One worker: a single list grown to GROW_NODES elements with no removals,
+ * so every node is a first allocation. Only the appends are timed.
+ */
+static void *grow_worker(void *arg) {
+    GrowTask *task = arg;
+    List *list = list_create_with_options(LIST_LINKED_SENTINEL, task->options);
+    task->start = now_sec();
+    for (size_t i = 0; list && i < GROW_NODES; ++i) {
+        list_append(list, (void *)(i + 1));
+    }
+    task->end = now_sec();
+    list_destroy(list, NULL);
+    return NULL;
+}
+
+/**
+ * M nodes/s for threads workers on one node source. Churn runs time the
+ * whole run; grow runs time the span from the first append to the last one,
+ * starting from empty caches (the depot is trimmed and the workers are new).
+ */
+static double thread_rate(size_t threads, const ListOptions *options, bool grow) {
+    pthread_t tids[MAX_THREADS];
+    GrowTask tasks[MAX_THREADS];
+    size_t started = 0;
+    if (grow) list_node_cache_trim();
+    double start = now_sec();
+    for (; started < threads; ++started) {
+        tasks[started] = (GrowTask){ options, 0.0, 0.0 };
+        void *arg = grow ? (void *)&tasks[started] : (void *)options;
+        if (pthread_create(&tids[started], NULL, grow ? grow_worker : thread_worker, arg) != 0) break;
+    }
+    for (size_t t = 0; t < started; ++t) {
+        pthread_join(tids[t], NULL);
+    }
+    double elapsed = now_sec() - start;
+    double nodes = (double)started * THREAD_ROUNDS * THREAD_NODES;
+    if (grow && started > 0) {
+        double first = tasks[0].start, last = tasks[0].end;
+        for (size_t t = 1; t < started; ++t) {
+            if (tasks[t].start < first) first = tasks[t].start;
+            if (tasks[t].end > last) last = tasks[t].end;
+        }
+        elapsed = last - first;
+        nodes = (double)started * GROW_NODES;
+    }
+    return nodes / elapsed / 1e6;
+}
+
+/**
+ * Aggregate node allocations per second for 1 to MAX_THREADS threads, per
+ * node source: threads that each churn short-lived lists (caches warm after
+ * the first round), then threads that each grow one list without freeing
+ * anything (every node is a cache miss). The counting hooks are off.
+ */
+static void bench_threads(void) {
+    for (int grow = 0; grow <= 1; ++grow) {
+        if (grow) {
+            printf("\n== Thread scaling, one list grown to %u nodes per thread (M nodes/s) ==\n",
+                   GROW_NODES);
+        } else {
+            printf("\n== Thread scaling, %u lists x %u nodes per thread (M nodes/s) ==\n",
+                   THREAD_ROUNDS, THREAD_NODES);
+        }
+        printf("%-8s", "threads");
+        for (size_t c = 0; c < NODE_CASES_COUNT; ++c) {
+            printf(" %14s", node_cases[c].name);
+        }
+        printf("\n");
+        for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2) {
+            printf("%-8zu", threads);
+            for (size_t c = 0; c < NODE_CASES_COUNT; ++c) {
+                printf(" %14.1f", thread_rate(threads, &node_cases[c].options, grow));
+            }
+            printf("\n");
+        }
+    }
+    list_node_cache_trim();
+}
+
+/**
+ * Allocation-bound loops for comparing the runtime-hook and static allocator
+ * builds: empty create/destroy pairs, a sentinel list whose slabs are capped
+ * at one node (one malloc per append), and tree appends plus teardown (one
+ * node per element). Run once per build; see `make bench-alloc`.
+ */
+static void bench_alloc(size_t n) {
+#ifdef LAB_STATIC_ALLOCATOR
+    const char *mode = "static";
+#else
+    const char *mode = "hooks";
+#endif
+    printf("\n== Allocator microbenchmarks (%s), %zu elements ==\n", mode, n);
+    printf("(default lists take one always-predicted branch on a per-list flag before ALLOC/DESTROY)\n");
+    printf("%-24s %12s %10s\n", "case", "total ms", "ns/op");
+
+    double start = now_sec();
+    for (size_t i = 0; i < n; ++i) {
+        List *list = list_create(LIST_LINKED_SENTINEL);
+        if (!list) return;
+        list_destroy(list, NULL);
+    }
+    double elapsed = now_sec() - start;
+    printf("%-24s %12.2f %10.1f\n", "create+destroy", elapsed * 1e3, elapsed * 1e9 / (double)n);
+
+    ListOptions one_node = { .slab_nodes = 1 };
+    start = now_sec();
+    List *list = filled_list_with(LIST_LINKED_SENTINEL, n, &one_node);
+    if (!list) return;
+    list_destroy(list, NULL);
+    elapsed = now_sec() - start;
+    printf("%-24s %12.2f %10.1f\n", "sentinel 1-node slabs", elapsed * 1e3, elapsed * 1e9 / (double)n);
+
+    start = now_sec();
+    list = filled_list(LIST_TREE, n);
+    if (!list) return;
+    list_destroy(list, NULL);
+    elapsed = now_sec() - start;
+    printf("%-24s %12.2f %10.1f\n", "tree append+destroy", elapsed * 1e3, elapsed * 1e9 / (double)n);
+}
+
+int main(int argc, char **argv) {
+    size_t n = DEFAULT_ELEMENTS;
+    if (argc > 1 && strcmp(argv[1], "--alloc") == 0) {
+        bench_alloc(argc > 2 ? (size_t)strtoull(argv[2], NULL, 10) : 10 * n);
+        return 0;
+    }
+    if (argc > 1) {
+        n = (size_t)strtoull(argv[1], NULL, 10);
+        if (n == 0) {
+            fprintf(stderr, "usage: %s [elements | --alloc [elements]]\n", argv[0]);
+            return 1;
+        }
+    }
+    bench_memory(n);
+    bench_operations(n);
+    bench_queue(n);
+    bench_clustered(n);
+    bench_seek(n);
+    bench_index(n);
+    bench_get_many(n);
+    bench_bulk(n);
+    bench_teardown(n);
+    bench_compact(n);
+    bench_regions(n);
+    bench_threads();
+    return 0;
+}
@@ -0,0 +1,252 @@
+#include "lab-internal.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Operations per decision window. The mix is re-evaluated at the end of each
+ * window and the window counters start over.
+ */
+#define ADAPTIVE_WINDOW 256
+
+/**
+ * A memmove'd slot is roughly this many times cheaper than a pointer-chasing
+ * hop to the next node, which is what the cost model below compares.
+ */
+#define ADAPTIVE_MEMMOVE_DISCOUNT 8
+
+_Static_assert(offsetof(AdaptiveState, layout) == 0,
+               "adaptive layout must alias list->linked / list->array");
+
+/**
+ * Estimated cost of the last window in "node hops" for each layout. Gets and
+ * middle edits walk half the list on average when linked; front edits shift
+ * the whole buffer when contiguous. Tail operations are O(1) in both.
+ * AI Use: AI Assisted
+ */
+static void adaptive_window_costs(const List *list, size_t *linked, size_t *array) {
+    const AdaptiveState *a = &list->adaptive;
+    size_t half = list->size / 2 + 1;
+    *linked = (a->window_gets + a->window_middle) * half + a->window_front + a->window_tail;
+    *array = a->window_gets + a->window_tail
+           + (a->window_middle * half + a->window_front * list->size) / ADAPTIVE_MEMMOVE_DISCOUNT;
+}
+
+/**
+ * Rebuilds the contents as a contiguous buffer. Returns false (and keeps the
+ * linked layout) if the buffer cannot be allocated.
+ * AI Use: AI Assisted
+ */
+static bool adaptive_to_array(List *list) {
+    size_t capacity = 8;
+    while (capacity < list->size) {
+        if (capacity > SIZE_MAX / 2 / sizeof(void *)) return false;
+        capacity *= 2;
+    }
+    void **slots = LIST_ALLOC(list, capacity * sizeof(void *));
+    if (!slots) return false;
+
+    Node *sentinel = list->adaptive.layout.linked.sentinel;
+    size_t i = 0;
+    for (Node *curr = sentinel->next; curr != sentinel; curr = curr->next) {
+        slots[i++] = curr->data;
+    }
+    list_sentinel_ops.destroy(list, NULL);
+    list->adaptive.layout.array.slots = slots;
+    list->adaptive.layout.array.capacity = capacity;
+    list->adaptive.layout.array.reserved = 0;
+    list->adaptive.inner = &list_array_ops;
+    list->adaptive.stats.to_array++;
+    return true;
+}
+
+/**
+ * Rebuilds the contents as a sentinel list. All nodes are allocated before the
+ * buffer is released, so a failed allocation keeps the array layout.
+ * AI Use: AI Assisted
+ */
+static bool adaptive_to_linked(List *list) {
+    ArrayState array = list->adaptive.layout.array; // overwritten by the sentinel state
+    if (!list_sentinel_ops.init(list, &list->adaptive.options)) {
+        list->adaptive.layout.array = array;
+        return false;
+    }
+    for (size_t i = 0; i < list->size; ++i) {
+        if (!list_sentinel_ops.append(list, array.slots[i])) {
+            list_sentinel_ops.destroy(list, NULL);
+            list->adaptive.layout.array = array;
+            return false;
+        }
+    }
+    if (array.slots) {
+        LIST_FREE(list, array.slots, array.capacity * sizeof(void *));
+    }
+    list->adaptive.inner = &list_sentinel_ops;
+    list->adaptive.stats.to_linked++;
+    return true;
+}
+
+/**
+ * Counts one operation and, at the end of a window, switches layout when the
+ * other one would have been at least twice as cheap and the saving over the
+ * window pays for the O(n) migration. That keeps migrations amortized.
+ * AI Use: AI Assisted
+ */
+static void adaptive_tick(List *list) {
+    AdaptiveState *a = &list->adaptive;
+    if (++a->window_ops < ADAPTIVE_WINDOW) return;
+
+    size_t linked, array;
+    adaptive_window_costs(list, &linked, &array);
+    size_t migrate = 2 * list->size;
+    if (a->inner == &list_sentinel_ops) {
+        if (array * 2 < linked && linked - array > migrate) {
+            (void)adaptive_to_array(list);
+        }
+    } else if (linked * 2 < array && array - linked > migrate) {
+        (void)adaptive_to_linked(list);
+    }
+
+    a->window_ops = 0;
+    a->window_gets = 0;
+    a->window_front = 0;
+    a->window_middle = 0;
+    a->window_tail = 0;
+}
+
+/**
+ * Records an indexed insert or remove at index against a list of size n.
+ * AI Use: AI Assisted
+ */
+static void adaptive_count_edit(AdaptiveState *a, size_t index, size_t n) {
+    if (index == 0) {
+        a->window_front++;
+    } else if (index + 1 >= n) {
+        a->window_tail++;
+    } else {
+        a->window_middle++;
+    }
+}
+
+/**
+ * Starts in the (lazily allocated) array layout with zeroed counters. The
+ * options are kept so a later linked layout gets the same node source and
+ * slab size.
+ * AI Use: AI Assisted
+ */
+static bool adaptive_init(List *list, const ListOptions *options) {
+    AdaptiveState *a = &list->adaptive;
+    a->inner = &list_array_ops;
+    a->window_ops = 0;
+    a->window_gets = 0;
+    a->window_front = 0;
+    a->window_middle = 0;
+    a->window_tail = 0;
+    a->stats = (ListAdaptiveStats){ 0 };
+    a->options = options ? *options : (ListOptions){ 0 };
+    return a->inner->init(list, &a->options);
+}
+
+static void adaptive_destroy(List *list, FreeFunc free_func) {
+    list->adaptive.inner->destroy(list, free_func);
+}
+
+/**
+ * Ticks before appending, like insert and remove, so a migration copies
+ * exactly the list->size elements lab.c knows about.
+ * AI Use: AI Assisted
+ */
+static bool adaptive_append(List *list, void *data) {
+    list->adaptive.window_tail++;
+    adaptive_tick(list);
+    if (!list->adaptive.inner->append(list, data)) return false;
+    list->adaptive.stats.appends++;
+    return true;
+}
+
+/**
+ * The tick runs before the insert so a migration never sees a size that
+ * lab.c has not accounted for yet.
+ * AI Use: AI Assisted
+ */
+static bool adaptive_insert(List *list, size_t index, void *data) {
+    adaptive_count_edit(&list->adaptive, index, list->size + 1);
+    adaptive_tick(list);
+    if (!list->adaptive.inner->insert(list, index, data)) return false;
+    list->adaptive.stats.inserts++;
+    return true;
+}
+
+static bool adaptive_remove(List *list, size_t index, void **out) {
+    adaptive_count_edit(&list->adaptive, index, list->size);
+    adaptive_tick(list);
+    if (!list->adaptive.inner->remove(list, index, out)) return false;
+    list->adaptive.stats.removes++;
+    return true;
+}
+
+/**
+ * Reads are counted too, so a read-heavy list can migrate from inside
+ * list_get; LIST_ADAPTIVE lists must not be read from several threads at once.
+ * AI Use: AI Assisted
+ */
+static void *adaptive_get(const List *list, size_t index) {
+    List *self = (List *)list; // counters only; the list itself is never const
+    self->adaptive.stats.gets++;
+    self->adaptive.window_gets++;
+    adaptive_tick(self);
+    return self->adaptive.inner->get(self, index);
+}
+
+/**
+ * A batch counts as n reads but only ticks once, and is served by whichever
+ * layout is current.
+ * AI Use: AI Assisted
+ */
+static bool adaptive_get_many(const List *list, const size_t *idx, size_t n, void **out) {
+    List *self = (List *)list; // counters only; the list itself is never const
+    self->adaptive.stats.gets += n;
+    self->adaptive.window_gets += n;
+    adaptive_tick(self);
+    return self->adaptive.inner->get_many(self, idx, n, out);
+}
+
+/**
+ * Full traversals are O(n) in both layouts, so they are not counted.
+ * AI Use: AI Assisted
+ */
+static bool adaptive_visit(List *list, ListSlotFn fn, void *ctx, bool write) {
+    return list->adaptive.inner->visit(list, fn, ctx, write);
+}
+
+/**
+ * Compacts the linked layout; the array layout is already contiguous.
+ * AI Use: AI Assisted
+ */
+static bool adaptive_compact(List *list) {
+    const ListOps *inner = list->adaptive.inner;
+    return inner->compact ? inner->compact(list) : true;
+}
+
+const ListOps list_adaptive_ops = {
+    .init = adaptive_init,
+    .destroy = adaptive_destroy,
+    .append = adaptive_append,
+    .insert = adaptive_insert,
+    .remove = adaptive_remove,
+    .get = adaptive_get,
+    .compact = adaptive_compact,
+    .get_many = adaptive_get_many,
+    .visit = adaptive_visit,
+};
+
+/**
+ * Copies the lifetime counters and the current layout into *stats.
+ * AI Use: AI Assisted
+ */
+bool list_adaptive_stats(const List *list, ListAdaptiveStats *stats) {
+    if (!list || !stats || list->type != LIST_ADAPTIVE) return false;
+    *stats = list->adaptive.stats;
+    stats->layout = list->adaptive.inner == &list_sentinel_ops ? LIST_LINKED_SENTINEL : LIST_ARRAY;
+    stats->migrations = stats->to_array + stats->to_linked;
+    return true;
+}
@@ -0,0 +1,105 @@
+#include "lab-internal.h"
+#include <stdalign.h>
+#include <stdint.h>
+
+/**
+ * Smallest chunk accepted for ListOptions::arena_chunk.
+ */
+#define ARENA_MIN_CHUNK 256
+
+/**
+ * Arena chunk header. data is aligned for any object type.
+ */
+struct ArenaChunk {
+    struct ArenaChunk *next;
+    alignas(max_align_t) char data[];
+};
+
+#define ARENA_ALIGN(size) (((size) + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1))
+
+/**
+ * Takes a chunk with room for size bytes from the backing allocator and links it in.
+ * AI Use: AI Assisted
+ */
+static ArenaChunk *arena_chunk_new(ListArena *arena, size_t size) {
+    ArenaChunk *chunk = arena->backing.alloc(arena->backing.ctx, sizeof(ArenaChunk) + size);
+    if (!chunk) return NULL;
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    return chunk;
+}
+
+/**
+ * Bumps the cursor, starting a new chunk when the current one is full.
+ * Requests larger than a chunk get a dedicated chunk of their own so the
+ * tail of the current chunk is not thrown away.
+ * AI Use: AI Assisted
+ */
+static void *arena_alloc(void *ctx, size_t size) {
+    ListArena *arena = ctx;
+    if (size > SIZE_MAX - sizeof(ArenaChunk) - alignof(max_align_t)) return NULL;
+    size = ARENA_ALIGN(size);
+    if (size > (size_t)(arena->end - arena->cursor)) {
+        if (size > arena->chunk_size / 2) {
+            ArenaChunk *big = arena_chunk_new(arena, size);
+            return big ? big->data : NULL; // cursor stays in the current chunk
+        }
+        ArenaChunk *chunk = arena_chunk_new(arena, arena->chunk_size);
+        if (!chunk) return NULL;
+        arena->cursor = chunk->data;
+        arena->end = chunk->data + arena->chunk_size;
+    }
+    void *block = arena->cursor;
+    arena->cursor += size;
+    return block;
+}
+
+/**
+ * Individual blocks are only reclaimed when the whole arena is released.
+ */
+static void arena_free(void *ctx, void *ptr) {
+    (void)ctx;
+    (void)ptr;
+}
+
+/**
+ * Switches list to arena mode: the allocator it was created with becomes the
+ * backing allocator for chunks, and every later backend allocation is bumped.
+ * No chunk is allocated until the first request.
+ * AI Use: AI Assisted
+ */
+bool list_arena_init(List *list, size_t chunk_size) {
+    if (chunk_size > SIZE_MAX / 2) return false;
+    ListArena *arena = &list->arena;
+    arena->chunks = NULL;
+    arena->cursor = NULL;
+    arena->end = NULL;
+    arena->chunk_size = ARENA_ALIGN(chunk_size < ARENA_MIN_CHUNK ? ARENA_MIN_CHUNK : chunk_size);
+    arena->backing = list->allocator;
+    list->allocator.alloc = arena_alloc;
+    list->allocator.free = arena_free;
+    list->allocator.ctx = arena;
+    list->default_alloc = false;
+    return true;
+}
+
+/**
+ * Returns every chunk to the backing allocator, which becomes the list's
+ * allocator again. O(chunks), independent of how many elements were stored.
+ * AI Use: AI Assisted
+ */
+void list_arena_release(List *list) {
+    ListArena *arena = &list->arena;
+    ArenaChunk *chunk = arena->chunks;
+    while (chunk) {
+        ArenaChunk *next = chunk->next;
+        arena->backing.free(arena->backing.ctx, chunk);
+        chunk = next;
+    }
+    arena->chunks = NULL;
+    arena->cursor = NULL;
+    arena->end = NULL;
+    arena->chunk_size = 0;
+    list->allocator = arena->backing;
+    list->default_alloc = arena->backing.alloc == lab_default_alloc;
+}
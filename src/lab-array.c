@@ -0,0 +1,167 @@
+#include "lab-internal.h"
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Smallest buffer allocated on the first append/insert.
+ */
+#define ARRAY_MIN_CAPACITY 8
+
+/**
+ * Moves the first `live` slots into a new buffer of new_capacity slots. The old
+ * buffer is only released once the copy succeeded, so a failed resize leaves the list intact.
+ * AI Use: AI Assisted
+ */
+static bool array_resize(List *list, size_t live, size_t new_capacity) {
+    if (new_capacity > SIZE_MAX / sizeof(void *)) return false;
+    void **slots = LIST_ALLOC(list, new_capacity * sizeof(void *));
+    if (!slots) return false;
+    if (live > 0) {
+        memcpy(slots, list->array.slots, live * sizeof(void *));
+    }
+    if (list->array.slots) {
+        LIST_FREE(list, list->array.slots, list->array.capacity * sizeof(void *));
+    }
+    list->array.slots = slots;
+    list->array.capacity = new_capacity;
+    return true;
+}
+
+/**
+ * Makes room for one more slot, doubling the buffer when it is full.
+ * AI Use: AI Assisted
+ */
+static bool array_reserve_one(List *list) {
+    if (list->size < list->array.capacity) return true;
+    size_t cap = list->array.capacity ? list->array.capacity * 2 : ARRAY_MIN_CAPACITY;
+    return array_resize(list, list->size, cap);
+}
+
+/**
+ * The buffer is allocated lazily, so an empty array list is just the List.
+ * AI Use: AI Assisted
+ */
+static bool array_init(List *list, const ListOptions *options) {
+    (void)options;
+    list->array.slots = NULL;
+    list->array.capacity = 0;
+    list->array.reserved = 0;
+    return true;
+}
+
+/**
+ * Frees the slot buffer, calling free_func on each element if provided.
+ * AI Use: AI Assisted
+ */
+static void array_destroy(List *list, FreeFunc free_func) {
+    if (free_func) {
+        for (size_t i = 0; i < list->size; ++i) {
+            if (list->array.slots[i]) {
+                free_func(list->array.slots[i]);
+            }
+        }
+    }
+    if (list->array.slots) {
+        LIST_FREE(list, list->array.slots, list->array.capacity * sizeof(void *));
+    }
+    list->array.slots = NULL;
+    list->array.capacity = 0;
+}
+
+/**
+ * Amortized O(1) append.
+ * AI Use: AI Assisted
+ */
+static bool array_append(List *list, void *data) {
+    if (!array_reserve_one(list)) return false;
+    list->array.slots[list->size] = data;
+    return true;
+}
+
+/**
+ * Shifts the tail up by one slot with memmove and stores data at index.
+ * AI Use: AI Assisted
+ */
+static bool array_insert(List *list, size_t index, void *data) {
+    if (!array_reserve_one(list)) return false;
+    void **slots = list->array.slots;
+    memmove(&slots[index + 1], &slots[index], (list->size - index) * sizeof(void *));
+    slots[index] = data;
+    return true;
+}
+
+/**
+ * Shifts the tail down over the removed slot. The buffer is halved once it
+ * drops to a quarter full (but not below what list_reserve asked for); if
+ * that allocation fails the larger buffer is kept.
+ * AI Use: AI Assisted
+ */
+static bool array_remove(List *list, size_t index, void **out) {
+    void **slots = list->array.slots;
+    void *data = slots[index];
+    size_t tail = list->size - index - 1;
+    memmove(&slots[index], &slots[index + 1], tail * sizeof(void *));
+
+    size_t remaining = list->size - 1;
+    size_t cap = list->array.capacity;
+    if (cap > ARRAY_MIN_CAPACITY && remaining <= cap / 4 && cap / 2 >= list->array.reserved) {
+        (void)array_resize(list, remaining, cap / 2);
+    }
+    *out = data;
+    return true;
+}
+
+/**
+ * O(1) indexed read.
+ * AI Use: AI Assisted
+ */
+static void *array_get(const List *list, size_t index) {
+    return list->array.slots[index];
+}
+
+/**
+ * Batched read straight from the slot buffer.
+ * AI Use: AI Assisted
+ */
+static bool array_get_many(const List *list, const size_t *idx, size_t n, void **out) {
+    void *const *slots = list->array.slots;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = slots[idx[i]];
+    }
+    return true;
+}
+
+static bool array_visit(List *list, ListSlotFn fn, void *ctx, bool write) {
+    (void)write;
+    for (size_t i = 0; i < list->size; ++i) {
+        if (!fn(&list->array.slots[i], ctx)) break;
+    }
+    return true;
+}
+
+/**
+ * Sizes the buffer for exactly n slots and keeps it from shrinking below that.
+ * AI Use: AI Assisted
+ */
+static bool array_reserve(List *list, size_t n) {
+    if (!array_resize(list, list->size, n)) return false;
+    list->array.reserved = n;
+    return true;
+}
+
+static size_t array_capacity(const List *list) {
+    return list->array.capacity;
+}
+
+const ListOps list_array_ops = {
+    .init = array_init,
+    .destroy = array_destroy,
+    .append = array_append,
+    .insert = array_insert,
+    .remove = array_remove,
+    .get = array_get,
+    .get_many = array_get_many,
+    .visit = array_visit,
+    .reserve = array_reserve,
+    .capacity = array_capacity,
+};
@@ -0,0 +1,523 @@
+#include "lab-internal.h"
+#include <stdatomic.h>
+#include <string.h>
+
+/**
+ * Data pointers per leaf and children per inner node. Both node kinds come
+ * out at a little over 512 bytes, i.e. eight cache lines.
+ */
+#define BTREE_LEAF_CAP 64
+#define BTREE_FANOUT 32
+
+/**
+ * Deepest tree supported; 64 * 32^15 elements is far beyond addressable memory.
+ */
+#define BTREE_MAX_DEPTH 16
+
+/**
+ * Leaf: a packed array of n data pointers. refs counts the parents (or list
+ * roots) pointing at the node; nodes with refs > 1 are shared with a snapshot
+ * and are copied before they are modified.
+ */
+typedef struct BLeaf {
+    atomic_size_t refs;
+    size_t n;
+    void *items[BTREE_LEAF_CAP];
+} BLeaf;
+
+/**
+ * Inner node: n children, each with the number of elements below it.
+ * Whether a child is a leaf follows from its depth, so nodes carry no tag.
+ */
+typedef struct BInner {
+    atomic_size_t refs;
+    size_t n;
+    size_t counts[BTREE_FANOUT];
+    void *child[BTREE_FANOUT];
+} BInner;
+
+static atomic_size_t *btree_refs(void *node, size_t depth) {
+    return depth ? &((BInner *)node)->refs : &((BLeaf *)node)->refs;
+}
+
+static BLeaf *btree_leaf_new(const List *list) {
+    BLeaf *leaf = LIST_ALLOC(list, sizeof(BLeaf));
+    if (!leaf) return NULL;
+    atomic_init(&leaf->refs, 1);
+    leaf->n = 0;
+    return leaf;
+}
+
+static BInner *btree_inner_new(const List *list) {
+    BInner *in = LIST_ALLOC(list, sizeof(BInner));
+    if (!in) return NULL;
+    atomic_init(&in->refs, 1);
+    in->n = 0;
+    return in;
+}
+
+static size_t btree_inner_total(const BInner *in) {
+    size_t total = 0;
+    for (size_t i = 0; i < in->n; ++i) {
+        total += in->counts[i];
+    }
+    return total;
+}
+
+/**
+ * Opens slot at in->child[at] and stores child/count there.
+ * AI Use: AI Assisted
+ */
+static void btree_inner_put(BInner *in, size_t at, void *child, size_t count) {
+    memmove(&in->child[at + 1], &in->child[at], (in->n - at) * sizeof(void *));
+    memmove(&in->counts[at + 1], &in->counts[at], (in->n - at) * sizeof(size_t));
+    in->child[at] = child;
+    in->counts[at] = count;
+    in->n++;
+}
+
+/**
+ * Closes the slot at in->child[at].
+ * AI Use: AI Assisted
+ */
+static void btree_inner_drop(BInner *in, size_t at) {
+    in->n--;
+    memmove(&in->child[at], &in->child[at + 1], (in->n - at) * sizeof(void *));
+    memmove(&in->counts[at], &in->counts[at + 1], (in->n - at) * sizeof(size_t));
+}
+
+/**
+ * Drops one reference to a subtree whose root sits `depth` inner levels above
+ * the leaves, freeing the nodes (and, through free_func, the elements of the
+ * leaves) that are no longer referenced by any version.
+ * AI Use: AI Assisted
+ */
+static void btree_release(const List *list, void *node, size_t depth, FreeFunc free_func) {
+    if (atomic_fetch_sub_explicit(btree_refs(node, depth), 1, memory_order_acq_rel) != 1) {
+        return;
+    }
+    if (depth == 0) {
+        BLeaf *leaf = node;
+        if (free_func) {
+            for (size_t i = 0; i < leaf->n; ++i) {
+                if (leaf->items[i]) {
+                    free_func(leaf->items[i]);
+                }
+            }
+        }
+    } else {
+        BInner *in = node;
+        for (size_t i = 0; i < in->n; ++i) {
+            btree_release(list, in->child[i], depth - 1, free_func);
+        }
+    }
+    LIST_FREE(list, node, depth ? sizeof(BInner) : sizeof(BLeaf));
+}
+
+/**
+ * Makes *slot exclusively owned by this list before it is modified: a shared
+ * node is replaced by a private copy that takes a reference on each child.
+ * Returns false if the copy could not be allocated; the tree is unchanged then.
+ * AI Use: AI Assisted
+ */
+static bool btree_unique(const List *list, void **slot, size_t depth) {
+    void *node = *slot;
+    if (atomic_load_explicit(btree_refs(node, depth), memory_order_acquire) == 1) {
+        return true;
+    }
+    if (depth == 0) {
+        const BLeaf *leaf = node;
+        BLeaf *copy = btree_leaf_new(list);
+        if (!copy) return false;
+        copy->n = leaf->n;
+        memcpy(copy->items, leaf->items, leaf->n * sizeof(void *));
+        *slot = copy;
+    } else {
+        const BInner *in = node;
+        BInner *copy = btree_inner_new(list);
+        if (!copy) return false;
+        copy->n = in->n;
+        memcpy(copy->counts, in->counts, in->n * sizeof(size_t));
+        memcpy(copy->child, in->child, in->n * sizeof(void *));
+        for (size_t i = 0; i < in->n; ++i) {
+            atomic_fetch_add_explicit(btree_refs(in->child[i], depth - 1), 1, memory_order_relaxed);
+        }
+        *slot = copy;
+    }
+    btree_release(list, node, depth, NULL);
+    return true;
+}
+
+/**
+ * Rebalances children l and l + 1 of parent after one of them underflowed:
+ * merges them when they fit in one node, otherwise moves a single element
+ * (or child) from the fuller one to the other.
+ * AI Use: AI Assisted
+ */
+static void btree_fix_pair(const List *list, BInner *parent, size_t l, bool leaves) {
+    size_t r = l + 1;
+    if (leaves) {
+        BLeaf *a = parent->child[l];
+        BLeaf *b = parent->child[r];
+        if (a->n + b->n <= BTREE_LEAF_CAP) {
+            memcpy(&a->items[a->n], b->items, b->n * sizeof(void *));
+            a->n += b->n;
+            parent->counts[l] += parent->counts[r];
+            btree_inner_drop(parent, r);
+            LIST_FREE(list, b, sizeof(BLeaf));
+        } else if (a->n < b->n) {
+            a->items[a->n++] = b->items[0];
+            memmove(b->items, &b->items[1], --b->n * sizeof(void *));
+            parent->counts[l]++;
+            parent->counts[r]--;
+        } else {
+            memmove(&b->items[1], b->items, b->n++ * sizeof(void *));
+            b->items[0] = a->items[--a->n];
+            parent->counts[l]--;
+            parent->counts[r]++;
+        }
+        return;
+    }
+
+    BInner *a = parent->child[l];
+    BInner *b = parent->child[r];
+    if (a->n + b->n <= BTREE_FANOUT) {
+        memcpy(&a->child[a->n], b->child, b->n * sizeof(void *));
+        memcpy(&a->counts[a->n], b->counts, b->n * sizeof(size_t));
+        a->n += b->n;
+        parent->counts[l] += parent->counts[r];
+        btree_inner_drop(parent, r);
+        LIST_FREE(list, b, sizeof(BInner));
+    } else if (a->n < b->n) {
+        size_t moved = b->counts[0];
+        btree_inner_put(a, a->n, b->child[0], moved);
+        btree_inner_drop(b, 0);
+        parent->counts[l] += moved;
+        parent->counts[r] -= moved;
+    } else {
+        size_t moved = a->counts[a->n - 1];
+        btree_inner_put(b, 0, a->child[a->n - 1], moved);
+        a->n--;
+        parent->counts[l] -= moved;
+        parent->counts[r] += moved;
+    }
+}
+
+/**
+ * The tree starts empty; the first insert allocates the root leaf.
+ * AI Use: AI Assisted
+ */
+static bool btree_init(List *list, const ListOptions *options) {
+    (void)options;
+    list->btree.root = NULL;
+    list->btree.height = 0;
+    return true;
+}
+
+/**
+ * Frees every node, calling free_func on each element if provided.
+ * AI Use: AI Assisted
+ */
+static void btree_destroy(List *list, FreeFunc free_func) {
+    if (list->btree.root) {
+        btree_release(list, list->btree.root, list->btree.height, free_func);
+    }
+    list->btree.root = NULL;
+    list->btree.height = 0;
+}
+
+/**
+ * O(log n) insert. Shared nodes on the path are copied first, and every node
+ * a split chain could need is allocated before the tree is modified, so a
+ * failed allocation leaves the list unchanged. Appends split full nodes at
+ * their end rather than in half, so lists built by list_append end up with
+ * packed leaves.
+ * AI Use: AI Assisted
+ */
+static bool btree_insert(List *list, size_t index, void *data) {
+    if (!list->btree.root) {
+        BLeaf *leaf = btree_leaf_new(list);
+        if (!leaf) return false;
+        list->btree.root = leaf;
+    }
+    if (!btree_unique(list, &list->btree.root, list->btree.height)) return false;
+
+    BInner *path[BTREE_MAX_DEPTH];
+    size_t slot[BTREE_MAX_DEPTH];
+    size_t height = list->btree.height;
+    bool at_end = index == list->size;
+    void *node = list->btree.root;
+    size_t pos = index;
+    for (size_t d = 0; d < height; ++d) {
+        BInner *in = node;
+        size_t s = 0;
+        while (s + 1 < in->n && pos > in->counts[s]) {
+            pos -= in->counts[s];
+            s++;
+        }
+        if (!btree_unique(list, &in->child[s], height - d - 1)) return false;
+        path[d] = in;
+        slot[d] = s;
+        node = in->child[s];
+    }
+    BLeaf *leaf = node;
+
+    // Reserve the leaf split, each full ancestor's split and possibly a new root
+    BLeaf *spare_leaf = NULL;
+    BInner *spare[BTREE_MAX_DEPTH + 1];
+    size_t spares = 0;
+    if (leaf->n == BTREE_LEAF_CAP) {
+        size_t inner_needed = 0;
+        size_t d = height;
+        while (d > 0 && path[d - 1]->n == BTREE_FANOUT) {
+            inner_needed++;
+            d--;
+        }
+        if (d == 0) {
+            if (height + 1 >= BTREE_MAX_DEPTH) return false;
+            inner_needed++; // the root splits too
+        }
+        spare_leaf = btree_leaf_new(list);
+        if (!spare_leaf) return false;
+        for (; spares < inner_needed; ++spares) {
+            spare[spares] = btree_inner_new(list);
+            if (!spare[spares]) {
+                while (spares > 0) {
+                    LIST_FREE(list, spare[--spares], sizeof(BInner));
+                }
+                LIST_FREE(list, spare_leaf, sizeof(BLeaf));
+                return false;
+            }
+        }
+    }
+
+    void *right = NULL;
+    size_t left_count = 0;
+    size_t right_count = 0;
+    if (leaf->n < BTREE_LEAF_CAP) {
+        memmove(&leaf->items[pos + 1], &leaf->items[pos], (leaf->n - pos) * sizeof(void *));
+        leaf->items[pos] = data;
+        leaf->n++;
+    } else {
+        BLeaf *split = spare_leaf;
+        size_t keep = at_end ? BTREE_LEAF_CAP : BTREE_LEAF_CAP / 2;
+        split->n = BTREE_LEAF_CAP - keep;
+        memcpy(split->items, &leaf->items[keep], split->n * sizeof(void *));
+        leaf->n = keep;
+        BLeaf *target = leaf;
+        if (pos > keep || keep == BTREE_LEAF_CAP) {
+            target = split;
+            pos -= keep;
+        }
+        memmove(&target->items[pos + 1], &target->items[pos], (target->n - pos) * sizeof(void *));
+        target->items[pos] = data;
+        target->n++;
+        right = split;
+        left_count = leaf->n;
+        right_count = split->n;
+    }
+
+    for (size_t d = height; d-- > 0;) {
+        BInner *in = path[d];
+        size_t s = slot[d];
+        if (!right) {
+            in->counts[s]++;
+            continue;
+        }
+        in->counts[s] = left_count;
+        if (in->n < BTREE_FANOUT) {
+            btree_inner_put(in, s + 1, right, right_count);
+            right = NULL;
+            continue;
+        }
+        BInner *split = spare[--spares];
+        size_t keep = at_end ? BTREE_FANOUT : BTREE_FANOUT / 2;
+        split->n = BTREE_FANOUT - keep;
+        memcpy(split->child, &in->child[keep], split->n * sizeof(void *));
+        memcpy(split->counts, &in->counts[keep], split->n * sizeof(size_t));
+        in->n = keep;
+        if (s + 1 <= keep && keep < BTREE_FANOUT) {
+            btree_inner_put(in, s + 1, right, right_count);
+        } else {
+            btree_inner_put(split, s + 1 - keep, right, right_count);
+        }
+        right = split;
+        left_count = btree_inner_total(in);
+        right_count = btree_inner_total(split);
+    }
+
+    if (right) {
+        BInner *root = spare[--spares];
+        root->n = 2;
+        root->child[0] = list->btree.root;
+        root->counts[0] = left_count;
+        root->child[1] = right;
+        root->counts[1] = right_count;
+        list->btree.root = root;
+        list->btree.height++;
+    }
+    return true;
+}
+
+/**
+ * Append is an insert at the last position.
+ * AI Use: AI Assisted
+ */
+static bool btree_append(List *list, void *data) {
+    return btree_insert(list, list->size, data);
+}
+
+/**
+ * O(log n) remove. Underfull nodes borrow from or merge with a sibling on the
+ * way back up, and the root collapses while it has a single child. The path,
+ * and any sibling that may be rebalanced, is made private before anything is
+ * changed, so running out of memory while copying leaves the list intact.
+ * AI Use: AI Assisted
+ */
+static bool btree_remove(List *list, size_t index, void **out) {
+    BInner *path[BTREE_MAX_DEPTH];
+    size_t slot[BTREE_MAX_DEPTH];
+    size_t height = list->btree.height;
+    if (!btree_unique(list, &list->btree.root, height)) return false;
+    void *node = list->btree.root;
+    size_t pos = index;
+    for (size_t d = 0; d < height; ++d) {
+        BInner *in = node;
+        size_t s = 0;
+        while (pos >= in->counts[s]) {
+            pos -= in->counts[s];
+            s++;
+        }
+        size_t depth = height - d - 1;
+        if (!btree_unique(list, &in->child[s], depth)) return false;
+        size_t child_n = depth ? ((BInner *)in->child[s])->n : ((BLeaf *)in->child[s])->n;
+        size_t child_min = depth ? BTREE_FANOUT / 2 : BTREE_LEAF_CAP / 2;
+        if (child_n <= child_min && in->n > 1) {
+            size_t sibling = s > 0 ? s - 1 : s + 1;
+            if (!btree_unique(list, &in->child[sibling], depth)) return false;
+        }
+        path[d] = in;
+        slot[d] = s;
+        node = in->child[s];
+    }
+    BLeaf *leaf = node;
+    void *data = leaf->items[pos];
+    leaf->n--;
+    memmove(&leaf->items[pos], &leaf->items[pos + 1], (leaf->n - pos) * sizeof(void *));
+
+    size_t child_n = leaf->n;
+    size_t child_min = BTREE_LEAF_CAP / 2;
+    for (size_t d = height; d-- > 0;) {
+        BInner *in = path[d];
+        size_t s = slot[d];
+        in->counts[s]--;
+        if (child_n < child_min && in->n > 1) {
+            btree_fix_pair(list, in, s > 0 ? s - 1 : s, d + 1 == height);
+        }
+        child_n = in->n;
+        child_min = BTREE_FANOUT / 2;
+    }
+
+    while (list->btree.height > 0 && ((BInner *)list->btree.root)->n == 1) {
+        BInner *old = list->btree.root;
+        list->btree.root = old->child[0];
+        list->btree.height--;
+        LIST_FREE(list, old, sizeof(BInner));
+    }
+    if (list->btree.height == 0 && ((BLeaf *)list->btree.root)->n == 0) {
+        LIST_FREE(list, list->btree.root, sizeof(BLeaf));
+        list->btree.root = NULL;
+    }
+    *out = data;
+    return true;
+}
+
+/**
+ * O(1) snapshot: the copy shares the whole tree and takes a reference on the root.
+ * AI Use: AI Assisted
+ */
+static void btree_share(List *copy, const List *list) {
+    copy->btree = list->btree;
+    if (list->btree.root) {
+        atomic_fetch_add_explicit(btree_refs(list->btree.root, list->btree.height), 1,
+                                  memory_order_relaxed);
+    }
+}
+
+/**
+ * O(log n) indexed read: scans the child counts of one node per level.
+ * AI Use: AI Assisted
+ */
+static void *btree_get(const List *list, size_t index) {
+    const void *node = list->btree.root;
+    for (size_t d = list->btree.height; d > 0; --d) {
+        const BInner *in = node;
+        size_t s = 0;
+        while (index >= in->counts[s]) {
+            index -= in->counts[s];
+            s++;
+        }
+        node = in->child[s];
+    }
+    return ((const BLeaf *)node)->items[index];
+}
+
+/**
+ * Makes the subtree at *slot and everything below it private to this list,
+ * so its leaves can be written. Returns false on allocation failure; the
+ * nodes copied so far stay copied, which does not change the contents.
+ * AI Use: AI Assisted
+ */
+static bool btree_unique_all(const List *list, void **slot, size_t depth) {
+    if (!btree_unique(list, slot, depth)) return false;
+    if (depth == 0) return true;
+    BInner *in = *slot;
+    for (size_t i = 0; i < in->n; ++i) {
+        if (!btree_unique_all(list, &in->child[i], depth - 1)) return false;
+    }
+    return true;
+}
+
+/**
+ * Visits the leaves of a subtree left to right, prefetching each next child
+ * before descending; returns false once fn asked to stop.
+ * AI Use: AI Assisted
+ */
+static bool btree_visit_node(void *node, size_t depth, ListSlotFn fn, void *ctx) {
+    if (depth == 0) {
+        BLeaf *leaf = node;
+        for (size_t i = 0; i < leaf->n; ++i) {
+            if (!fn(&leaf->items[i], ctx)) return false;
+        }
+        return true;
+    }
+    BInner *in = node;
+    for (size_t i = 0; i < in->n; ++i) {
+        if (i + 1 < in->n) LAB_PREFETCH(in->child[i + 1]);
+        if (!btree_visit_node(in->child[i], depth - 1, fn, ctx)) return false;
+    }
+    return true;
+}
+
+/**
+ * With write set, shared nodes are copied before anything is visited, so a
+ * map never shows through to a snapshot and a failed copy changes nothing.
+ * AI Use: AI Assisted
+ */
+static bool btree_visit(List *list, ListSlotFn fn, void *ctx, bool write) {
+    if (!list->btree.root) return true;
+    if (write && !btree_unique_all(list, &list->btree.root, list->btree.height)) return false;
+    (void)btree_visit_node(list->btree.root, list->btree.height, fn, ctx);
+    return true;
+}
+
+const ListOps list_btree_ops = {
+    .init = btree_init,
+    .destroy = btree_destroy,
+    .append = btree_append,
+    .insert = btree_insert,
+    .remove = btree_remove,
+    .get = btree_get,
+    .share = btree_share,
+    .visit = btree_visit,
+};
@@ -0,0 +1,195 @@
+#include "lab-internal.h"
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Capacity of the first buffer.
+ */
+#define GAP_MIN_CAPACITY 8
+
+/**
+ * Number of slots after the gap.
+ */
+#define GAP_TAIL(list) ((list)->gap.capacity - (list)->gap.gap_end)
+
+/**
+ * Moves the gap so it starts at logical index pos, sliding only the slots
+ * between the old and new gap position.
+ * AI Use: AI Assisted
+ */
+static void gap_move_to(List *list, size_t pos) {
+    void **slots = list->gap.slots;
+    size_t start = list->gap.gap_start;
+    if (pos < start) {
+        size_t moved = start - pos;
+        memmove(&slots[list->gap.gap_end - moved], &slots[pos], moved * sizeof(void *));
+        list->gap.gap_start -= moved;
+        list->gap.gap_end -= moved;
+    } else if (pos > start) {
+        size_t moved = pos - start;
+        memmove(&slots[start], &slots[list->gap.gap_end], moved * sizeof(void *));
+        list->gap.gap_start += moved;
+        list->gap.gap_end += moved;
+    }
+}
+
+/**
+ * Moves the elements into a buffer of capacity slots (at least list->size),
+ * keeping the prefix at the front and the suffix at the back so the (now
+ * larger) gap stays where it was.
+ * AI Use: AI Assisted
+ */
+static bool gap_resize(List *list, size_t capacity) {
+    if (capacity > SIZE_MAX / sizeof(void *)) return false;
+    void **slots = LIST_ALLOC(list, capacity * sizeof(void *));
+    if (!slots) return false;
+    size_t tail = GAP_TAIL(list);
+    if (list->gap.slots) {
+        memcpy(slots, list->gap.slots, list->gap.gap_start * sizeof(void *));
+        memcpy(&slots[capacity - tail], &list->gap.slots[list->gap.gap_end], tail * sizeof(void *));
+        LIST_FREE(list, list->gap.slots, list->gap.capacity * sizeof(void *));
+    }
+    list->gap.slots = slots;
+    list->gap.capacity = capacity;
+    list->gap.gap_end = capacity - tail;
+    return true;
+}
+
+/**
+ * Doubles the buffer (or allocates the first one).
+ */
+static bool gap_grow(List *list) {
+    size_t capacity = list->gap.capacity;
+    return gap_resize(list, capacity ? capacity * 2 : GAP_MIN_CAPACITY);
+}
+
+/**
+ * The buffer is allocated lazily on the first insert.
+ * AI Use: AI Assisted
+ */
+static bool gap_init(List *list, const ListOptions *options) {
+    (void)options;
+    list->gap.slots = NULL;
+    list->gap.capacity = 0;
+    list->gap.gap_start = 0;
+    list->gap.gap_end = 0;
+    return true;
+}
+
+/**
+ * Frees the buffer, calling free_func on each element if provided.
+ * AI Use: AI Assisted
+ */
+static void gap_destroy(List *list, FreeFunc free_func) {
+    if (free_func) {
+        void **slots = list->gap.slots;
+        for (size_t i = 0; i < list->gap.gap_start; ++i) {
+            if (slots[i]) free_func(slots[i]);
+        }
+        for (size_t i = list->gap.gap_end; i < list->gap.capacity; ++i) {
+            if (slots[i]) free_func(slots[i]);
+        }
+    }
+    if (list->gap.slots) {
+        LIST_FREE(list, list->gap.slots, list->gap.capacity * sizeof(void *));
+    }
+    list->gap.slots = NULL;
+    list->gap.capacity = 0;
+}
+
+/**
+ * Inserts at the gap after moving it to index. Runs of inserts at or next to
+ * the previous position only move a handful of slots.
+ * AI Use: AI Assisted
+ */
+static bool gap_insert(List *list, size_t index, void *data) {
+    if (list->gap.gap_start == list->gap.gap_end && !gap_grow(list)) return false;
+    gap_move_to(list, index);
+    list->gap.slots[list->gap.gap_start++] = data;
+    return true;
+}
+
+/**
+ * Append moves the gap to the end; after the first call it is already there.
+ * AI Use: AI Assisted
+ */
+static bool gap_append(List *list, void *data) {
+    return gap_insert(list, list->size, data);
+}
+
+/**
+ * Removes by moving the gap to index and widening it over the element.
+ * AI Use: AI Assisted
+ */
+static bool gap_remove(List *list, size_t index, void **out) {
+    gap_move_to(list, index);
+    *out = list->gap.slots[list->gap.gap_end++];
+    return true;
+}
+
+/**
+ * O(1) indexed read: indices past the gap skip over it.
+ * AI Use: AI Assisted
+ */
+static void *gap_get(const List *list, size_t index) {
+    if (index < list->gap.gap_start) {
+        return list->gap.slots[index];
+    }
+    return list->gap.slots[index + (list->gap.gap_end - list->gap.gap_start)];
+}
+
+/**
+ * Batched read straight from the buffer, skipping the gap.
+ * AI Use: AI Assisted
+ */
+static bool gap_get_many(const List *list, const size_t *idx, size_t n, void **out) {
+    void *const *slots = list->gap.slots;
+    size_t start = list->gap.gap_start;
+    size_t width = list->gap.gap_end - start;
+    for (size_t i = 0; i < n; ++i) {
+        size_t index = idx[i];
+        out[i] = slots[index < start ? index : index + width];
+    }
+    return true;
+}
+
+/**
+ * Visits the slots before the gap, then the ones after it.
+ * AI Use: AI Assisted
+ */
+static bool gap_visit(List *list, ListSlotFn fn, void *ctx, bool write) {
+    (void)write;
+    void **slots = list->gap.slots;
+    for (size_t i = 0; i < list->gap.gap_start; ++i) {
+        if (!fn(&slots[i], ctx)) return true;
+    }
+    for (size_t i = list->gap.gap_end; i < list->gap.capacity; ++i) {
+        if (!fn(&slots[i], ctx)) return true;
+    }
+    return true;
+}
+
+/**
+ * Sizes the buffer for n elements; the gap takes up the difference.
+ * AI Use: AI Assisted
+ */
+static bool gap_reserve(List *list, size_t n) {
+    return gap_resize(list, n);
+}
+
+static size_t gap_capacity(const List *list) {
+    return list->gap.capacity;
+}
+
+const ListOps list_gap_ops = {
+    .init = gap_init,
+    .destroy = gap_destroy,
+    .append = gap_append,
+    .insert = gap_insert,
+    .remove = gap_remove,
+    .get = gap_get,
+    .get_many = gap_get_many,
+    .visit = gap_visit,
+    .reserve = gap_reserve,
+    .capacity = gap_capacity,
+};
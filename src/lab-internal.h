@@ -0,0 +1,371 @@
+#ifndef LAB_INTERNAL_H
+#define LAB_INTERNAL_H
+
+/**
+ * @file lab-internal.h
+ * @brief Private definitions shared by lab.c and the list backends.
+ * Nothing in here is part of the public API in lab.h.
+ */
+
+#include "lab.h"
+
+/**
+ * The allocator of lists created without list_create_with_allocator. It
+ * forwards to ALLOC / DESTROY.
+ */
+void *lab_default_alloc(void *ctx, size_t size);
+void lab_default_free(void *ctx, void *ptr);
+
+/**
+ * Every allocation a backend makes goes through the allocator stored in its
+ * List, so one list's storage never mixes allocators. Lists on the default
+ * allocator skip the indirect call and reach ALLOC / DESTROY directly (the
+ * compile-time allocator with LAB_STATIC_ALLOCATOR, the hooks otherwise).
+ * That costs one branch on List::default_alloc, which is fixed when the list
+ * is created and so always predicted; it is the only branch left in front of
+ * the static allocator.
+ */
+#define LIST_RAW_ALLOC(list, size)                                              \
+    ((list)->default_alloc ? ALLOC(size) : (list)->allocator.alloc((list)->allocator.ctx, (size)))
+#define LIST_RAW_FREE(list, ptr)                                                \
+    do {                                                                        \
+        if ((list)->default_alloc) DESTROY(ptr);                                \
+        else (list)->allocator.free((list)->allocator.ctx, (ptr));              \
+    } while (0)
+
+/**
+ * LIST_ALLOC / LIST_FREE are what backends call. LIST_FREE takes the size that
+ * was passed to LIST_ALLOC so list_memory_stats can be kept without a header
+ * per block. With LAB_NO_MEMORY_STATS both reduce to the raw calls above.
+ */
+#ifdef LAB_NO_MEMORY_STATS
+#define LIST_ALLOC(list, size) LIST_RAW_ALLOC(list, size)
+#define LIST_FREE(list, ptr, size) do { (void)(size); LIST_RAW_FREE(list, ptr); } while (0)
+#else
+#define LIST_ALLOC(list, size) list_counted_alloc(list, size)
+#define LIST_FREE(list, ptr, size) list_counted_free(list, ptr, size)
+#endif
+
+/**
+ * Bump allocator behind ListOptions::arena_chunk. Chunks come from backing
+ * (the allocator the list was created with); frees are ignored, and
+ * list_arena_release hands the chunks back in one pass. chunk_size is 0 for
+ * lists that are not arena-backed.
+ */
+typedef struct ArenaChunk ArenaChunk;
+typedef struct ListArena {
+    ArenaChunk *chunks;
+    char *cursor;               // next free byte in chunks
+    char *end;                  // end of the usable part of chunks
+    size_t chunk_size;
+    ListAllocator backing;
+} ListArena;
+
+/**
+ * Node structure for the circular, doubly linked list.
+ */
+typedef struct Node {
+    void *data;
+    struct Node *prev;
+    struct Node *next;
+} Node;
+
+/**
+ * State for LIST_LINKED_SENTINEL. Nodes are carved out of per-list slabs and
+ * recycled through an intrusive free list (chained through Node::next), so
+ * only slab growth allocates. Slabs double from one node up to slab_max.
+ * With thread_cache set the slab fields are unused. finger caches the node
+ * at finger_index from the last indexed access (NULL when unknown), so
+ * index seeks can start from it as well as from either end. With a nonzero
+ * stride (list_enable_index), checkpoints[j] is the node at j * stride for
+ * the first checkpoint_count entries; edits shorten that valid prefix and
+ * seeks extend it again.
+ */
+typedef struct NodeSlab NodeSlab;
+typedef struct SentinelState {
+    Node *sentinel;
+    NodeSlab *slabs;            // every slab owned by the list
+    Node *free_nodes;           // unused nodes, chained through next
+    size_t free_count;          // nodes on free_nodes
+    size_t slab_next;           // nodes in the next slab to allocate
+    size_t slab_max;            // cap on slab_next
+    bool thread_cache;          // nodes come from the process-wide node cache instead
+    Node *finger;               // never the sentinel
+    size_t finger_index;
+    Node **checkpoints;
+    size_t checkpoint_count;    // valid prefix of checkpoints
+    size_t checkpoint_capacity;
+    size_t stride;              // 0 when the index is off
+} SentinelState;
+
+/**
+ * Called by ListOps::visit with a pointer to each element's slot, in list
+ * order. Returns false to stop the walk.
+ */
+typedef bool (*ListSlotFn)(void **slot, void *ctx);
+
+/**
+ * Hint that addr will be read soon. Used by the linked walks, where the next
+ * node's address is known one step before it is needed.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define LAB_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define LAB_PREFETCH(addr) ((void)(addr))
+#endif
+
+/**
+ * Node-level access for ListIter on linked backends. The backend position is it->node (plus it->offset inside a chunk);
+ * lab.c keeps it->index and it->list. The end position must be reachable
+ * with prev so a cursor can always step back from it.
+ */
+typedef struct ListCursorOps {
+    void (*seek)(ListIter *it);                                 // position for it->index <= size
+    void (*next)(ListIter *it);
+    void (*prev)(ListIter *it);
+    void *(*data)(const ListIter *it);
+    bool (*insert_before)(ListIter *it, void *data);            // it stays on the same element
+    void *(*remove)(ListIter *it);                              // returns the element, it moves
+                                                                // onto the successor
+} ListCursorOps;
+
+/**
+ * Per-backend operations. lab.c does the NULL and bounds checks and keeps
+ * list->size up to date, so backends only move data around. remove stores the
+ * element in *out and returns false only if it could not allocate (copy-on-write).
+ */
+typedef struct ListOps {
+    bool (*init)(List *list, const ListOptions *options);   // set up empty state; options may be NULL
+    void (*destroy)(List *list, FreeFunc free_func);        // release everything but the List itself
+    bool (*append)(List *list, void *data);
+    bool (*insert)(List *list, size_t index, void *data);
+    bool (*remove)(List *list, size_t index, void **out);
+    void *(*get)(const List *list, size_t index);
+    void (*share)(List *copy, const List *list);        // optional: O(1) structural snapshot
+    bool (*reserve)(List *list, size_t n);              // optional: room for n elements without allocating
+    size_t (*capacity)(const List *list);               // set together with reserve
+    bool (*compact)(List *list);                        // optional: relayout for sequential access
+    const ListCursorOps *cursor;                        // optional: O(1) ListIter steps and edits
+    bool (*enable_index)(List *list, size_t k);         // optional: sparse seek index every k elements
+    bool (*get_many)(const List *list, const size_t *idx, size_t n, void **out); // optional: batched get;
+                                                        // false only on allocation failure
+    bool (*visit)(List *list, ListSlotFn fn, void *ctx, bool write); // in-order walk over the
+                                                        // element slots; with write set the slots may be
+                                                        // stored to, and false means that could not be
+                                                        // arranged (copy-on-write) and nothing was visited
+} ListOps;
+
+/**
+ * One request of a batched get, in the order list_gather_order sorts them.
+ */
+typedef struct ListGather {
+    size_t index;               // list position to read
+    size_t slot;                // where the result goes in out[]
+} ListGather;
+
+/**
+ * State for LIST_ARRAY: one contiguous, geometrically grown slot buffer.
+ */
+typedef struct ArrayState {
+    void **slots;
+    size_t capacity;
+    size_t reserved;            // list_reserve floor; the buffer never shrinks below it
+} ArrayState;
+
+/**
+ * State for LIST_UNROLLED: a doubly linked chain of fixed-capacity chunks.
+ */
+typedef struct Chunk Chunk;
+typedef struct UnrolledState {
+    Chunk *head;
+    Chunk *tail;
+    size_t capacity;            // data pointers per chunk
+} UnrolledState;
+
+/**
+ * State for LIST_TREE: root of a size-augmented AVL tree.
+ */
+typedef struct TreeNode TreeNode;
+typedef struct TreeState {
+    TreeNode *root;
+} TreeState;
+
+/**
+ * State for LIST_SKIP: indexable skip list whose links carry span widths.
+ */
+typedef struct SkipNode SkipNode;
+typedef struct SkipState {
+    SkipNode *header;
+    size_t level;               // levels currently in use
+    uint64_t rng;               // xorshift state for tower heights
+} SkipState;
+
+/**
+ * State for LIST_RING: power-of-two circular buffer. Logical index i lives in
+ * slots[(head + i) & (capacity - 1)].
+ */
+typedef struct RingState {
+    void **slots;
+    size_t capacity;
+    size_t head;
+} RingState;
+
+/**
+ * State for LIST_BTREE: counted B+tree. root is a leaf when height is 0,
+ * otherwise an inner node `height` levels above the leaves.
+ */
+typedef struct BTreeState {
+    void *root;
+    size_t height;
+} BTreeState;
+
+/**
+ * State for LIST_GAP: gap buffer. Elements occupy [0, gap_start) and
+ * [gap_end, capacity); the slots in between are the movable gap.
+ */
+typedef struct GapState {
+    void **slots;
+    size_t capacity;
+    size_t gap_start;
+    size_t gap_end;
+} GapState;
+
+/**
+ * State for LIST_TIERED: directory of circular tiers of width 1 << shift.
+ * All tiers but the last are full, so index i is in tier i >> shift.
+ */
+typedef struct Tier Tier;
+typedef struct TieredState {
+    Tier **tiers;
+    size_t count;               // tiers in use
+    size_t dir_capacity;        // slots in the tiers directory
+    size_t shift;               // log2 of the tier width
+} TieredState;
+
+/**
+ * State for LIST_ADAPTIVE. layout must stay the first member: it overlays
+ * list->linked / list->array, so the sentinel and array ops can run on the
+ * list unchanged while inner points at whichever of them is in use.
+ */
+typedef struct AdaptiveState {
+    union {
+        SentinelState linked;
+        ArrayState array;
+    } layout;
+    const ListOps *inner;
+    size_t window_ops;          // operations in the current decision window
+    size_t window_gets;
+    size_t window_front;        // inserts/removes at index 0
+    size_t window_middle;       // inserts/removes away from both ends
+    size_t window_tail;         // appends and inserts/removes at the end
+    ListAdaptiveStats stats;
+    ListOptions options;        // as created; every layout is initialized with them
+} AdaptiveState;
+
+/**
+ * List structure definition. The union holds the state of whichever backend
+ * list->type selected in list_create.
+ */
+struct List {
+    size_t size;
+    ListType type;
+    const ListOps *ops;
+    ListAllocator allocator;    // where all backend storage comes from
+    bool default_alloc;         // allocator is the default one; see LIST_RAW_ALLOC
+    ListArena arena;            // arena mode only; allocator then points into it
+#ifndef LAB_NO_MEMORY_STATS
+    ListMemStats mem;           // see list_memory_stats
+    size_t mem_limit;           // list_set_memory_limit; SIZE_MAX when unlimited
+    ListLimitPolicy limit_policy;
+    FreeFunc evict_func;        // called on elements evicted by LIST_LIMIT_EVICT_HEAD
+    bool limit_hit;             // an allocation was refused by mem_limit
+#endif
+    union {
+        SentinelState linked;   // LIST_LINKED_SENTINEL
+        ArrayState array;       // LIST_ARRAY
+        UnrolledState unrolled; // LIST_UNROLLED
+        TreeState tree;         // LIST_TREE
+        SkipState skip;         // LIST_SKIP
+        RingState ring;         // LIST_RING
+        BTreeState btree;       // LIST_BTREE
+        GapState gap;           // LIST_GAP
+        TieredState tiered;     // LIST_TIERED
+        AdaptiveState adaptive; // LIST_ADAPTIVE
+    };
+};
+
+#ifndef LAB_NO_MEMORY_STATS
+/**
+ * Books a block of size bytes against the list. list is only const because
+ * some backend helpers take a const List; the counters are always writable.
+ */
+static inline void list_mem_charge(const List *list, size_t size) {
+    ListMemStats *m = &((List *)list)->mem;
+    m->bytes += size;
+    m->live_nodes++;
+    m->alloc_calls++;
+    if (m->bytes > m->peak_bytes) m->peak_bytes = m->bytes;
+}
+
+/**
+ * Releases a block booked with list_mem_charge. Snapshot handles free nodes
+ * that another handle allocated, so the counters stop at zero instead of
+ * wrapping.
+ */
+static inline void list_mem_credit(const List *list, size_t size) {
+    ListMemStats *m = &((List *)list)->mem;
+    m->bytes = m->bytes > size ? m->bytes - size : 0;
+    if (m->live_nodes) m->live_nodes--;
+}
+
+/**
+ * The budget check of list_set_memory_limit: refuses (and flags) an
+ * allocation that would take the list over mem_limit.
+ */
+static inline bool list_mem_admit(const List *list, size_t size) {
+    if (size > list->mem_limit || list->mem.bytes > list->mem_limit - size) {
+        ((List *)list)->limit_hit = true;
+        return false;
+    }
+    return true;
+}
+
+static inline void *list_counted_alloc(const List *list, size_t size) {
+    if (!list_mem_admit(list, size)) return NULL;
+    void *ptr = LIST_RAW_ALLOC(list, size);
+    if (ptr) list_mem_charge(list, size);
+    return ptr;
+}
+
+static inline void list_counted_free(const List *list, void *ptr, size_t size) {
+    LIST_RAW_FREE(list, ptr);
+    list_mem_credit(list, size);
+}
+#else
+#define list_mem_admit(list, size) true
+#define list_mem_charge(list, size) ((void)0)
+#define list_mem_credit(list, size) ((void)0)
+#endif
+
+Node *node_cache_alloc(void);
+void node_cache_free(Node *node);
+ListNodeSource node_cache_default_source(void);
+
+bool list_gather_order(const size_t *idx, size_t n, ListGather **order);
+void list_gather_free(ListGather *order);
+
+bool list_arena_init(List *list, size_t chunk_size);
+void list_arena_release(List *list);
+
+extern const ListOps list_sentinel_ops;
+extern const ListOps list_array_ops;
+extern const ListOps list_unrolled_ops;
+extern const ListOps list_tree_ops;
+extern const ListOps list_skip_ops;
+extern const ListOps list_ring_ops;
+extern const ListOps list_btree_ops;
+extern const ListOps list_gap_ops;
+extern const ListOps list_tiered_ops;
+extern const ListOps list_adaptive_ops;
+
+#endif // LAB_INTERNAL_H
@@ -0,0 +1,210 @@
+#include "lab-internal.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+/**
+ * Nodes a thread hands to the depot at once; a thread keeps up to twice this
+ * many free nodes before it does.
+ */
+#define NODE_MAGAZINE 64
+
+/**
+ * Magazines the depot holds. Nodes flushed beyond that go back to DESTROY.
+ */
+#define NODE_DEPOT_MAX 256
+
+/**
+ * A chain of free nodes linked through Node::next.
+ */
+typedef struct NodeMagazine {
+    Node *head;
+    size_t count;
+} NodeMagazine;
+
+/**
+ * Per-thread free nodes. registered is set once the thread-exit destructor
+ * that flushes the magazine to the depot has been armed.
+ */
+typedef struct NodeThreadCache {
+    NodeMagazine mag;
+    bool registered;
+} NodeThreadCache;
+
+static _Thread_local NodeThreadCache thread_cache;
+
+static pthread_mutex_t depot_lock = PTHREAD_MUTEX_INITIALIZER;
+static NodeMagazine depot[NODE_DEPOT_MAX];
+static atomic_size_t depot_count = 0;   // written under depot_lock; read without it as a hint
+
+static pthread_once_t cache_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t cache_key;
+
+static atomic_int default_source = LIST_NODES_SLAB;
+
+static void node_chain_free(Node *node) {
+    while (node) {
+        Node *next = node->next;
+        DESTROY(node);
+        node = next;
+    }
+}
+
+/**
+ * Parks a magazine in the depot, or frees its nodes when the depot is full.
+ * AI Use: AI Assisted
+ */
+static void depot_put(NodeMagazine mag) {
+    pthread_mutex_lock(&depot_lock);
+    size_t count = atomic_load_explicit(&depot_count, memory_order_relaxed);
+    if (count < NODE_DEPOT_MAX) {
+        depot[count] = mag;
+        atomic_store_explicit(&depot_count, count + 1, memory_order_relaxed);
+        mag.head = NULL;
+    }
+    pthread_mutex_unlock(&depot_lock);
+    node_chain_free(mag.head);
+}
+
+/**
+ * Thread-exit destructor: the exiting thread's free nodes go to the depot.
+ */
+static void thread_cache_exit(void *arg) {
+    NodeThreadCache *tc = arg;
+    if (tc->mag.head) {
+        depot_put(tc->mag);
+    }
+    tc->mag = (NodeMagazine){ NULL, 0 };
+}
+
+static void cache_key_create(void) {
+    (void)pthread_key_create(&cache_key, thread_cache_exit);
+}
+
+/**
+ * Arms the thread-exit flush the first time a thread touches its cache.
+ * AI Use: AI Assisted
+ */
+static void thread_cache_register(NodeThreadCache *tc) {
+    pthread_once(&cache_key_once, cache_key_create);
+    (void)pthread_setspecific(cache_key, tc);
+    tc->registered = true;
+}
+
+/**
+ * Takes a whole magazine from the depot into mag (which is empty). The lock
+ * is skipped while the depot looks empty, so growing lists never touch it.
+ * AI Use: AI Assisted
+ */
+static void depot_take(NodeMagazine *mag) {
+    if (atomic_load_explicit(&depot_count, memory_order_relaxed) == 0) return;
+    pthread_mutex_lock(&depot_lock);
+    size_t count = atomic_load_explicit(&depot_count, memory_order_relaxed);
+    if (count > 0) {
+        *mag = depot[count - 1];
+        atomic_store_explicit(&depot_count, count - 1, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&depot_lock);
+}
+
+/**
+ * Fills an empty magazine with up to NODE_MAGAZINE new nodes in one go.
+ * Nodes stay separate blocks because surplus nodes and list_node_cache_trim
+ * release them one at a time. Returns false if not even one was allocated.
+ * AI Use: AI Assisted
+ */
+static bool magazine_fill(NodeMagazine *mag) {
+    for (size_t i = 0; i < NODE_MAGAZINE; ++i) {
+        Node *node = ALLOC(sizeof(Node));
+        if (!node) break;
+        node->next = mag->head;
+        mag->head = node;
+        mag->count++;
+    }
+    return mag->head != NULL;
+}
+
+/**
+ * Takes a node from the calling thread's magazine. When it runs dry it is
+ * refilled with a magazine from the depot or, failing that, with a fresh
+ * batch of nodes, so the depot lock is taken at most once per NODE_MAGAZINE
+ * allocations and never while the depot is empty.
+ * AI Use: AI Assisted
+ */
+Node *node_cache_alloc(void) {
+    NodeThreadCache *tc = &thread_cache;
+    if (!tc->mag.head) {
+        depot_take(&tc->mag);
+        if (!tc->mag.head && !magazine_fill(&tc->mag)) return NULL;
+        if (!tc->registered) {
+            thread_cache_register(tc);
+        }
+    }
+    Node *node = tc->mag.head;
+    tc->mag.head = node->next;
+    tc->mag.count--;
+    return node;
+}
+
+/**
+ * Returns a node to the calling thread's magazine (whichever thread allocated
+ * it). Once the thread holds two magazines' worth, one is moved to the depot.
+ * AI Use: AI Assisted
+ */
+void node_cache_free(Node *node) {
+    NodeThreadCache *tc = &thread_cache;
+    if (!tc->registered) {
+        thread_cache_register(tc);
+    }
+    node->next = tc->mag.head;
+    tc->mag.head = node;
+    if (++tc->mag.count < 2 * NODE_MAGAZINE) return;
+
+    NodeMagazine full = { tc->mag.head, NODE_MAGAZINE };
+    Node *last = tc->mag.head;
+    for (size_t i = 1; i < NODE_MAGAZINE; ++i) {
+        last = last->next;
+    }
+    tc->mag.head = last->next;
+    tc->mag.count -= NODE_MAGAZINE;
+    last->next = NULL;
+    depot_put(full);
+}
+
+/**
+ * Resolves LIST_NODES_DEFAULT for a new list.
+ */
+ListNodeSource node_cache_default_source(void) {
+    return (ListNodeSource)atomic_load_explicit(&default_source, memory_order_relaxed);
+}
+
+/**
+ * Sets the node source that LIST_NODES_DEFAULT resolves to.
+ * AI Use: AI Assisted
+ */
+void list_set_default_node_source(ListNodeSource source) {
+    if (source == LIST_NODES_DEFAULT) {
+        source = LIST_NODES_SLAB;
+    }
+    atomic_store_explicit(&default_source, (int)source, memory_order_relaxed);
+}
+
+/**
+ * Frees the depot and the calling thread's magazine.
+ * AI Use: AI Assisted
+ */
+void list_node_cache_trim(void) {
+    NodeMagazine taken[NODE_DEPOT_MAX];
+    pthread_mutex_lock(&depot_lock);
+    size_t count = atomic_load_explicit(&depot_count, memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        taken[i] = depot[i];
+    }
+    atomic_store_explicit(&depot_count, 0, memory_order_relaxed);
+    pthread_mutex_unlock(&depot_lock);
+
+    for (size_t i = 0; i < count; ++i) {
+        node_chain_free(taken[i].head);
+    }
+    node_chain_free(thread_cache.mag.head);
+    thread_cache.mag = (NodeMagazine){ NULL, 0 };
+}
@@ -0,0 +1,225 @@
+#include "lab-internal.h"
+#include <stdalign.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * Default and smallest region sizes. The default is one x86-64 huge page.
+ */
+#define REGION_DEFAULT_SIZE ((size_t)2 << 20)
+#define REGION_MIN_SIZE ((size_t)64 << 10)
+
+#define REGION_ALIGN(size) (((size) + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1))
+
+/**
+ * Header at the start of every mapping. Mappings are aligned to the pool's
+ * region_size, so the region owning a block is found by masking its address.
+ * A block too large for a region gets a dedicated mapping (length >
+ * region_size) that is unmapped as soon as the block is freed.
+ */
+typedef struct Region {
+    struct Region *next_all;    // every standard region of the pool
+    struct Region *next_idle;   // empty regions waiting for reuse
+    size_t length;              // mapping length
+    size_t live;                // blocks handed out and not yet freed
+    char *cursor;
+    char *end;
+} Region;
+
+#define REGION_HEADER REGION_ALIGN(sizeof(Region))
+
+struct ListRegionPool {
+    size_t region_size;         // power of two
+    size_t page_size;
+    bool huge_pages;
+    Region *current;            // region being bump-allocated from
+    Region *all;
+    Region *idle;
+    ListRegionStats stats;
+};
+
+/**
+ * Maps length bytes aligned to align (a power of two) by over-mapping and
+ * trimming both ends. Returns NULL on failure.
+ * AI Use: AI Assisted
+ */
+static void *region_map(const ListRegionPool *pool, size_t length, size_t align) {
+    if (length > SIZE_MAX - align) return NULL;
+    char *raw = mmap(NULL, length + align, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return NULL;
+    uintptr_t start = ((uintptr_t)raw + align - 1) & ~(uintptr_t)(align - 1);
+    size_t head = (size_t)(start - (uintptr_t)raw);
+    if (head > 0) {
+        munmap(raw, head);
+    }
+    if (align - head > 0) {
+        munmap((char *)start + length, align - head);
+    }
+#ifdef MADV_HUGEPAGE
+    if (pool->huge_pages) {
+        (void)madvise((void *)start, length, MADV_HUGEPAGE); // best effort
+    }
+#else
+    (void)pool;
+#endif
+    return (void *)start;
+}
+
+/**
+ * Drops the pages behind everything but the header page, so an empty region
+ * stops counting towards RSS while staying mapped for reuse. The whole
+ * region is dropped, not just the part below the cursor: with huge pages the
+ * first touch faults in the full 2 MiB page, untouched tail included.
+ * AI Use: AI Assisted
+ */
+static void region_reset(const ListRegionPool *pool, Region *region) {
+    (void)madvise((char *)region + pool->page_size, region->length - pool->page_size, MADV_DONTNEED);
+    region->cursor = (char *)region + REGION_HEADER;
+}
+
+/**
+ * Returns an empty standard region: an idle one if available, otherwise a new mapping.
+ * AI Use: AI Assisted
+ */
+static Region *region_take(ListRegionPool *pool) {
+    Region *region = pool->idle;
+    if (region) {
+        pool->idle = region->next_idle;
+        pool->stats.idle_regions--;
+        return region;
+    }
+    region = region_map(pool, pool->region_size, pool->region_size);
+    if (!region) return NULL;
+    region->next_all = pool->all;
+    region->next_idle = NULL;
+    region->length = pool->region_size;
+    region->live = 0;
+    region->cursor = (char *)region + REGION_HEADER;
+    region->end = (char *)region + pool->region_size;
+    pool->all = region;
+    pool->stats.regions++;
+    pool->stats.mapped_bytes += pool->region_size;
+    return region;
+}
+
+/**
+ * Bump allocation from the current region. Blocks that do not fit in an
+ * empty region get a dedicated mapping.
+ * AI Use: AI Assisted
+ */
+static void *region_alloc(void *ctx, size_t size) {
+    ListRegionPool *pool = ctx;
+    if (size > SIZE_MAX / 2) return NULL;
+    size = REGION_ALIGN(size ? size : 1);
+
+    if (size > pool->region_size - REGION_HEADER) {
+        size_t length = (REGION_HEADER + size + pool->page_size - 1) & ~(pool->page_size - 1);
+        Region *big = region_map(pool, length, pool->region_size);
+        if (!big) return NULL;
+        big->length = length;
+        big->live = 1;
+        pool->stats.mapped_bytes += length;
+        pool->stats.live_blocks++;
+        return (char *)big + REGION_HEADER;
+    }
+
+    Region *region = pool->current;
+    if (!region || size > (size_t)(region->end - region->cursor)) {
+        region = region_take(pool);
+        if (!region) return NULL;
+        pool->current = region; // the old one goes idle once its last block is freed
+    }
+    void *block = region->cursor;
+    region->cursor += size;
+    region->live++;
+    pool->stats.live_blocks++;
+    return block;
+}
+
+/**
+ * Releases one block. Space inside a region is only reused once every block
+ * in it has been freed; the region's pages are then dropped with
+ * MADV_DONTNEED and it is reused for later allocations.
+ * AI Use: AI Assisted
+ */
+static void region_free(void *ctx, void *ptr) {
+    ListRegionPool *pool = ctx;
+    if (!ptr) return;
+    Region *region = (Region *)((uintptr_t)ptr & ~(uintptr_t)(pool->region_size - 1));
+    pool->stats.live_blocks--;
+    if (--region->live > 0) return;
+
+    if (region->length > pool->region_size) {
+        pool->stats.mapped_bytes -= region->length;
+        munmap(region, region->length);
+        return;
+    }
+    region_reset(pool, region);
+    if (region != pool->current) {
+        region->next_idle = pool->idle;
+        pool->idle = region;
+        pool->stats.idle_regions++;
+    }
+}
+
+/**
+ * Creates an empty pool; regions are mapped on demand.
+ * AI Use: AI Assisted
+ */
+ListRegionPool *list_region_pool_create(size_t region_size, bool huge_pages) {
+    if (region_size == 0) {
+        region_size = REGION_DEFAULT_SIZE;
+    }
+    if (region_size > SIZE_MAX / 4) return NULL;
+    size_t size = REGION_MIN_SIZE;
+    while (size < region_size) {
+        size *= 2;
+    }
+    long page = sysconf(_SC_PAGESIZE);
+    ListRegionPool *pool = ALLOC(sizeof(ListRegionPool));
+    if (!pool) return NULL;
+    pool->region_size = size;
+    pool->page_size = page > 0 ? (size_t)page : 4096;
+    pool->huge_pages = huge_pages;
+    pool->current = NULL;
+    pool->all = NULL;
+    pool->idle = NULL;
+    pool->stats = (ListRegionStats){ 0 };
+    return pool;
+}
+
+/**
+ * Unmaps every standard region and frees the pool.
+ * AI Use: AI Assisted
+ */
+void list_region_pool_destroy(ListRegionPool *pool) {
+    if (!pool) return;
+    Region *region = pool->all;
+    while (region) {
+        Region *next = region->next_all;
+        munmap(region, pool->region_size);
+        region = next;
+    }
+    DESTROY(pool);
+}
+
+/**
+ * Wraps the pool in a ListAllocator for list_create_with_allocator.
+ * AI Use: AI Assisted
+ */
+ListAllocator list_region_allocator(ListRegionPool *pool) {
+    ListAllocator allocator = { region_alloc, region_free, pool };
+    return allocator;
+}
+
+/**
+ * Copies the pool counters into *stats.
+ * AI Use: AI Assisted
+ */
+bool list_region_pool_stats(const ListRegionPool *pool, ListRegionStats *stats) {
+    if (!pool || !stats) return false;
+    *stats = pool->stats;
+    return true;
+}
@@ -0,0 +1,188 @@
+#include "lab-internal.h"
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Capacity of the first buffer. Must be a power of two.
+ */
+#define RING_MIN_CAPACITY 8
+
+/**
+ * Slot holding logical index i. capacity is a power of two, so wrapping is a mask.
+ */
+#define RING_SLOT(list, i) ((list)->ring.slots[((list)->ring.head + (i)) & ((list)->ring.capacity - 1)])
+
+/**
+ * Moves the elements into a buffer of capacity slots (a power of two, at
+ * least list->size), unwrapping them so the head lands on slot 0. The old
+ * buffer is only released after the copy, so failure leaves the list intact.
+ * AI Use: AI Assisted
+ */
+static bool ring_resize(List *list, size_t capacity) {
+    size_t old_capacity = list->ring.capacity;
+    if (capacity > SIZE_MAX / sizeof(void *)) return false;
+    void **slots = LIST_ALLOC(list, capacity * sizeof(void *));
+    if (!slots) return false;
+    if (list->size > 0) {
+        size_t first = old_capacity - list->ring.head; // slots before the wrap
+        if (first > list->size) first = list->size;
+        memcpy(slots, &list->ring.slots[list->ring.head], first * sizeof(void *));
+        memcpy(&slots[first], list->ring.slots, (list->size - first) * sizeof(void *));
+    }
+    if (list->ring.slots) {
+        LIST_FREE(list, list->ring.slots, list->ring.capacity * sizeof(void *));
+    }
+    list->ring.slots = slots;
+    list->ring.capacity = capacity;
+    list->ring.head = 0;
+    return true;
+}
+
+/**
+ * Doubles the buffer (or allocates the first one).
+ */
+static bool ring_grow(List *list) {
+    size_t capacity = list->ring.capacity;
+    return ring_resize(list, capacity ? capacity * 2 : RING_MIN_CAPACITY);
+}
+
+/**
+ * The buffer is allocated lazily on the first insert.
+ * AI Use: AI Assisted
+ */
+static bool ring_init(List *list, const ListOptions *options) {
+    (void)options;
+    list->ring.slots = NULL;
+    list->ring.capacity = 0;
+    list->ring.head = 0;
+    return true;
+}
+
+/**
+ * Frees the buffer, calling free_func on each element if provided.
+ * AI Use: AI Assisted
+ */
+static void ring_destroy(List *list, FreeFunc free_func) {
+    if (free_func) {
+        for (size_t i = 0; i < list->size; ++i) {
+            void *data = RING_SLOT(list, i);
+            if (data) {
+                free_func(data);
+            }
+        }
+    }
+    if (list->ring.slots) {
+        LIST_FREE(list, list->ring.slots, list->ring.capacity * sizeof(void *));
+    }
+    list->ring.slots = NULL;
+    list->ring.capacity = 0;
+}
+
+/**
+ * O(1) push at the tail; only allocates when the buffer is full.
+ * AI Use: AI Assisted
+ */
+static bool ring_append(List *list, void *data) {
+    if (list->size == list->ring.capacity && !ring_grow(list)) return false;
+    RING_SLOT(list, list->size) = data;
+    return true;
+}
+
+/**
+ * Opens a slot at index by shifting whichever side of it is shorter, so
+ * pushes at either end are O(1).
+ * AI Use: AI Assisted
+ */
+static bool ring_insert(List *list, size_t index, void *data) {
+    if (list->size == list->ring.capacity && !ring_grow(list)) return false;
+    if (index < list->size / 2) {
+        list->ring.head = (list->ring.head - 1) & (list->ring.capacity - 1);
+        for (size_t i = 0; i < index; ++i) {
+            RING_SLOT(list, i) = RING_SLOT(list, i + 1);
+        }
+    } else {
+        for (size_t i = list->size; i > index; --i) {
+            RING_SLOT(list, i) = RING_SLOT(list, i - 1);
+        }
+    }
+    RING_SLOT(list, index) = data;
+    return true;
+}
+
+/**
+ * Closes the gap at index from the shorter side, so pops at either end are
+ * O(1). The buffer is never shrunk, keeping queue-shaped use allocation-free.
+ * AI Use: AI Assisted
+ */
+static bool ring_remove(List *list, size_t index, void **out) {
+    void *data = RING_SLOT(list, index);
+    if (index < list->size / 2) {
+        for (size_t i = index; i > 0; --i) {
+            RING_SLOT(list, i) = RING_SLOT(list, i - 1);
+        }
+        list->ring.head = (list->ring.head + 1) & (list->ring.capacity - 1);
+    } else {
+        for (size_t i = index; i + 1 < list->size; ++i) {
+            RING_SLOT(list, i) = RING_SLOT(list, i + 1);
+        }
+    }
+    *out = data;
+    return true;
+}
+
+/**
+ * O(1) indexed read by masked offset from the head.
+ * AI Use: AI Assisted
+ */
+static void *ring_get(const List *list, size_t index) {
+    return RING_SLOT(list, index);
+}
+
+/**
+ * Batched read straight from the ring.
+ * AI Use: AI Assisted
+ */
+static bool ring_get_many(const List *list, const size_t *idx, size_t n, void **out) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = RING_SLOT(list, idx[i]);
+    }
+    return true;
+}
+
+static bool ring_visit(List *list, ListSlotFn fn, void *ctx, bool write) {
+    (void)write;
+    for (size_t i = 0; i < list->size; ++i) {
+        if (!fn(&RING_SLOT(list, i), ctx)) break;
+    }
+    return true;
+}
+
+/**
+ * Grows the buffer to the next power of two that holds n elements.
+ * AI Use: AI Assisted
+ */
+static bool ring_reserve(List *list, size_t n) {
+    size_t capacity = RING_MIN_CAPACITY;
+    while (capacity < n) {
+        if (capacity > SIZE_MAX / 2) return false;
+        capacity *= 2;
+    }
+    return ring_resize(list, capacity);
+}
+
+static size_t ring_capacity(const List *list) {
+    return list->ring.capacity;
+}
+
+const ListOps list_ring_ops = {
+    .init = ring_init,
+    .destroy = ring_destroy,
+    .append = ring_append,
+    .insert = ring_insert,
+    .remove = ring_remove,
+    .get = ring_get,
+    .get_many = ring_get_many,
+    .visit = ring_visit,
+    .reserve = ring_reserve,
+    .capacity = ring_capacity,
+};
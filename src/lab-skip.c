@@ -0,0 +1,242 @@
+#include "lab-internal.h"
+
+/**
+ * Tallest tower a node can get. With p = 1/4 this covers 4^32 elements.
+ */
+#define SKIP_MAX_LEVEL 32
+
+/**
+ * Seed used when ListOptions::seed is 0, so runs are reproducible by default.
+ */
+#define SKIP_DEFAULT_SEED 0x9E3779B97F4A7C15ull
+
+/**
+ * Forward link of a skip-list node. span is how many list positions the link
+ * jumps over; a NULL next is treated as position size + 1.
+ */
+typedef struct SkipLink {
+    struct SkipNode *next;
+    size_t span;
+} SkipLink;
+
+/**
+ * Skip-list node with a tower of `level` forward links.
+ */
+struct SkipNode {
+    void *data;
+    size_t level;
+    SkipLink links[];
+};
+
+#define SKIP_NODE_BYTES(level) (sizeof(SkipNode) + (level) * sizeof(SkipLink))
+
+/**
+ * xorshift64* step on the per-list RNG state.
+ * AI Use: AI Assisted
+ */
+static uint64_t skip_next_random(List *list) {
+    uint64_t x = list->skip.rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    list->skip.rng = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+/**
+ * Draws a tower height with P(level > k) = 4^-k, two random bits per level.
+ * AI Use: AI Assisted
+ */
+static size_t skip_random_level(List *list) {
+    uint64_t bits = skip_next_random(list);
+    size_t level = 1;
+    while (level < SKIP_MAX_LEVEL && (bits & 3u) == 0) {
+        level++;
+        bits >>= 2;
+    }
+    return level;
+}
+
+static SkipNode *skip_node_new(const List *list, size_t level, void *data) {
+    SkipNode *node = LIST_ALLOC(list, SKIP_NODE_BYTES(level));
+    if (!node) return NULL;
+    node->data = data;
+    node->level = level;
+    return node;
+}
+
+/**
+ * Fills update[] with the last node at each level whose position is at most
+ * index (the header counts as position 0), and rank[] with those positions.
+ * Both insert and remove at index splice right after these nodes.
+ * AI Use: AI Assisted
+ */
+static void skip_find_predecessors(const List *list, size_t index,
+                                   SkipNode **update, size_t *rank) {
+    SkipNode *x = list->skip.header;
+    size_t pos = 0;
+    size_t l = list->skip.level; // always >= 1
+    do {
+        --l;
+        while (x->links[l].next && pos + x->links[l].span <= index) {
+            pos += x->links[l].span;
+            x = x->links[l].next;
+        }
+        update[l] = x;
+        rank[l] = pos;
+    } while (l > 0);
+}
+
+/**
+ * Seeds the RNG and allocates a full-height header node.
+ * AI Use: AI Assisted
+ */
+static bool skip_init(List *list, const ListOptions *options) {
+    SkipNode *header = skip_node_new(list, SKIP_MAX_LEVEL, NULL);
+    if (!header) return false;
+    for (size_t l = 0; l < SKIP_MAX_LEVEL; ++l) {
+        header->links[l].next = NULL;
+        header->links[l].span = 1;
+    }
+    uint64_t seed = options ? options->seed : 0;
+    list->skip.header = header;
+    list->skip.level = 1;
+    list->skip.rng = seed ? seed : SKIP_DEFAULT_SEED;
+    return true;
+}
+
+/**
+ * Walks level 0 freeing every node, calling free_func on each element if provided.
+ * AI Use: AI Assisted
+ */
+static void skip_destroy(List *list, FreeFunc free_func) {
+    SkipNode *x = list->skip.header->links[0].next;
+    while (x) {
+        SkipNode *next = x->links[0].next;
+        if (free_func && x->data) {
+            free_func(x->data);
+        }
+        LIST_FREE(list, x, SKIP_NODE_BYTES(x->level));
+        x = next;
+    }
+    LIST_FREE(list, list->skip.header, SKIP_NODE_BYTES(list->skip.header->level));
+    list->skip.header = NULL;
+}
+
+/**
+ * Expected O(log n) insert: links a new tower after the predecessors and
+ * widens the spans that now jump over one more element.
+ * AI Use: AI Assisted
+ */
+static bool skip_insert(List *list, size_t index, void *data) {
+    SkipNode *update[SKIP_MAX_LEVEL];
+    size_t rank[SKIP_MAX_LEVEL];
+    size_t level = skip_random_level(list);
+    SkipNode *node = skip_node_new(list, level, data);
+    if (!node) return false;
+
+    skip_find_predecessors(list, index, update, rank);
+    SkipNode *header = list->skip.header;
+    for (size_t l = list->skip.level; l < level; ++l) {
+        update[l] = header;
+        rank[l] = 0;
+        header->links[l].next = NULL;
+        header->links[l].span = list->size + 1;
+    }
+    if (level > list->skip.level) {
+        list->skip.level = level;
+    }
+
+    size_t pos = index + 1; // position of the new node
+    for (size_t l = 0; l < level; ++l) {
+        SkipLink *link = &update[l]->links[l];
+        node->links[l].next = link->next;
+        node->links[l].span = rank[l] + link->span + 1 - pos;
+        link->next = node;
+        link->span = pos - rank[l];
+    }
+    for (size_t l = level; l < list->skip.level; ++l) {
+        update[l]->links[l].span++;
+    }
+    return true;
+}
+
+/**
+ * Append is an insert at the last position.
+ * AI Use: AI Assisted
+ */
+static bool skip_append(List *list, void *data) {
+    return skip_insert(list, list->size, data);
+}
+
+/**
+ * Expected O(log n) remove: unlinks the tower and narrows the spans above it.
+ * AI Use: AI Assisted
+ */
+static bool skip_remove(List *list, size_t index, void **out) {
+    SkipNode *update[SKIP_MAX_LEVEL];
+    size_t rank[SKIP_MAX_LEVEL];
+    skip_find_predecessors(list, index, update, rank);
+
+    SkipNode *x = update[0]->links[0].next;
+    for (size_t l = 0; l < list->skip.level; ++l) {
+        SkipLink *link = &update[l]->links[l];
+        if (link->next == x) {
+            link->span += x->links[l].span - 1;
+            link->next = x->links[l].next;
+        } else {
+            link->span--;
+        }
+    }
+    while (list->skip.level > 1 && list->skip.header->links[list->skip.level - 1].next == NULL) {
+        list->skip.level--;
+    }
+
+    void *data = x->data;
+    LIST_FREE(list, x, SKIP_NODE_BYTES(x->level));
+    *out = data;
+    return true;
+}
+
+/**
+ * Expected O(log n) indexed read, jumping by span from the top level down.
+ * AI Use: AI Assisted
+ */
+static void *skip_get(const List *list, size_t index) {
+    const SkipNode *x = list->skip.header;
+    size_t pos = 0;
+    size_t target = index + 1;
+    for (size_t l = list->skip.level; l-- > 0;) {
+        while (x->links[l].next && pos + x->links[l].span <= target) {
+            pos += x->links[l].span;
+            x = x->links[l].next;
+        }
+        if (pos == target) break;
+    }
+    return x->data;
+}
+
+/**
+ * Walks level 0, prefetching the node after the next one.
+ * AI Use: AI Assisted
+ */
+static bool skip_visit(List *list, ListSlotFn fn, void *ctx, bool write) {
+    (void)write;
+    for (SkipNode *x = list->skip.header->links[0].next; x;) {
+        SkipNode *next = x->links[0].next;
+        if (next) LAB_PREFETCH(next->links[0].next);
+        if (!fn(&x->data, ctx)) break;
+        x = next;
+    }
+    return true;
+}
+
+const ListOps list_skip_ops = {
+    .init = skip_init,
+    .destroy = skip_destroy,
+    .append = skip_append,
+    .insert = skip_insert,
+    .remove = skip_remove,
+    .get = skip_get,
+    .visit = skip_visit,
+};
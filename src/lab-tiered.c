@@ -0,0 +1,297 @@
+#include "lab-internal.h"
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Smallest tier width as a power of two (8 slots).
+ */
+#define TIERED_MIN_SHIFT 3
+
+/**
+ * One tier: a circular buffer of 1 << shift slots.
+ */
+struct Tier {
+    size_t head;
+    size_t count;
+    void *slots[];
+};
+
+#define TIER_WIDTH(list) ((size_t)1 << (list)->tiered.shift)
+#define TIER_BYTES(width) (sizeof(Tier) + (width) * sizeof(void *))
+#define TIER_MASK(list) (TIER_WIDTH(list) - 1)
+#define TIER_SLOT(list, tier, i) ((tier)->slots[((tier)->head + (i)) & TIER_MASK(list)])
+
+static Tier *tier_new(const List *list) {
+    Tier *tier = LIST_ALLOC(list, TIER_BYTES(TIER_WIDTH(list)));
+    if (!tier) return NULL;
+    tier->head = 0;
+    tier->count = 0;
+    return tier;
+}
+
+/**
+ * Inserts into a non-full tier at offset, shifting the shorter side.
+ * AI Use: AI Assisted
+ */
+static void tier_insert(const List *list, Tier *tier, size_t offset, void *data) {
+    if (offset < tier->count / 2) {
+        tier->head = (tier->head - 1) & TIER_MASK(list);
+        for (size_t i = 0; i < offset; ++i) {
+            TIER_SLOT(list, tier, i) = TIER_SLOT(list, tier, i + 1);
+        }
+    } else {
+        for (size_t i = tier->count; i > offset; --i) {
+            TIER_SLOT(list, tier, i) = TIER_SLOT(list, tier, i - 1);
+        }
+    }
+    TIER_SLOT(list, tier, offset) = data;
+    tier->count++;
+}
+
+/**
+ * Removes the element at offset of a tier, shifting the shorter side.
+ * AI Use: AI Assisted
+ */
+static void *tier_remove(const List *list, Tier *tier, size_t offset) {
+    void *data = TIER_SLOT(list, tier, offset);
+    if (offset < tier->count / 2) {
+        for (size_t i = offset; i > 0; --i) {
+            TIER_SLOT(list, tier, i) = TIER_SLOT(list, tier, i - 1);
+        }
+        tier->head = (tier->head + 1) & TIER_MASK(list);
+    } else {
+        for (size_t i = offset; i + 1 < tier->count; ++i) {
+            TIER_SLOT(list, tier, i) = TIER_SLOT(list, tier, i + 1);
+        }
+    }
+    tier->count--;
+    return data;
+}
+
+/**
+ * Frees tiers[0..count) (each width slots wide) and the directory itself,
+ * which has room for dir_capacity tiers.
+ * AI Use: AI Assisted
+ */
+static void tiered_free_tiers(const List *list, Tier **tiers, size_t count,
+                              size_t dir_capacity, size_t width) {
+    for (size_t i = 0; i < count; ++i) {
+        LIST_FREE(list, tiers[i], TIER_BYTES(width));
+    }
+    if (tiers) {
+        LIST_FREE(list, tiers, dir_capacity * sizeof(Tier *));
+    }
+}
+
+/**
+ * Repacks the n elements into tiers of width 1 << shift. On allocation
+ * failure the current layout is kept, which is still correct, just not
+ * optimally sized.
+ * AI Use: AI Assisted
+ */
+static void tiered_rebuild(List *list, size_t n, size_t shift) {
+    size_t width = (size_t)1 << shift;
+    size_t count = (n + width - 1) / width;
+    size_t dir_capacity = count + 1;
+    Tier **tiers = LIST_ALLOC(list, dir_capacity * sizeof(Tier *));
+    if (!tiers) return;
+    size_t made = 0;
+    for (; made < count; ++made) {
+        tiers[made] = LIST_ALLOC(list, TIER_BYTES(width));
+        if (!tiers[made]) {
+            tiered_free_tiers(list, tiers, made, dir_capacity, width);
+            return;
+        }
+        tiers[made]->head = 0;
+        tiers[made]->count = 0;
+    }
+
+    size_t out = 0;
+    for (size_t t = 0; t < list->tiered.count; ++t) {
+        Tier *tier = list->tiered.tiers[t];
+        for (size_t i = 0; i < tier->count; ++i, ++out) {
+            Tier *dst = tiers[out >> shift];
+            dst->slots[dst->count++] = TIER_SLOT(list, tier, i);
+        }
+    }
+
+    tiered_free_tiers(list, list->tiered.tiers, list->tiered.count,
+                      list->tiered.dir_capacity, TIER_WIDTH(list));
+    list->tiered.tiers = tiers;
+    list->tiered.count = count;
+    list->tiered.dir_capacity = dir_capacity;
+    list->tiered.shift = shift;
+}
+
+/**
+ * Starts with the narrowest tiers and no storage.
+ * AI Use: AI Assisted
+ */
+static bool tiered_init(List *list, const ListOptions *options) {
+    (void)options;
+    list->tiered.tiers = NULL;
+    list->tiered.count = 0;
+    list->tiered.dir_capacity = 0;
+    list->tiered.shift = TIERED_MIN_SHIFT;
+    return true;
+}
+
+/**
+ * Frees every tier, calling free_func on each element if provided.
+ * AI Use: AI Assisted
+ */
+static void tiered_destroy(List *list, FreeFunc free_func) {
+    if (free_func) {
+        for (size_t t = 0; t < list->tiered.count; ++t) {
+            Tier *tier = list->tiered.tiers[t];
+            for (size_t i = 0; i < tier->count; ++i) {
+                void *data = TIER_SLOT(list, tier, i);
+                if (data) free_func(data);
+            }
+        }
+    }
+    tiered_free_tiers(list, list->tiered.tiers, list->tiered.count,
+                      list->tiered.dir_capacity, TIER_WIDTH(list));
+    list->tiered.tiers = NULL;
+    list->tiered.count = 0;
+    list->tiered.dir_capacity = 0;
+}
+
+/**
+ * Adds an empty tier at the end, growing the directory if needed.
+ * AI Use: AI Assisted
+ */
+static bool tiered_add_tier(List *list) {
+    if (list->tiered.count == list->tiered.dir_capacity) {
+        size_t capacity = list->tiered.dir_capacity ? list->tiered.dir_capacity * 2 : 4;
+        if (capacity > SIZE_MAX / sizeof(Tier *)) return false;
+        Tier **tiers = LIST_ALLOC(list, capacity * sizeof(Tier *));
+        if (!tiers) return false;
+        if (list->tiered.tiers) {
+            memcpy(tiers, list->tiered.tiers, list->tiered.count * sizeof(Tier *));
+            LIST_FREE(list, list->tiered.tiers, list->tiered.dir_capacity * sizeof(Tier *));
+        }
+        list->tiered.tiers = tiers;
+        list->tiered.dir_capacity = capacity;
+    }
+    Tier *tier = tier_new(list);
+    if (!tier) return false;
+    list->tiered.tiers[list->tiered.count++] = tier;
+    return true;
+}
+
+/**
+ * O(sqrt n) insert: shifts inside the target tier, then each later tier
+ * passes its last element to the front of the next one in O(1). Every tier
+ * but the last stays full, which is what keeps list_get O(1).
+ * AI Use: AI Assisted
+ */
+static bool tiered_insert(List *list, size_t index, void *data) {
+    size_t width = TIER_WIDTH(list);
+    if (list->size == list->tiered.count * width && !tiered_add_tier(list)) return false;
+
+    size_t t = index >> list->tiered.shift;
+    size_t offset = index & TIER_MASK(list);
+    void *carry = data;
+    for (; t < list->tiered.count; ++t, offset = 0) {
+        Tier *tier = list->tiered.tiers[t];
+        void *overflow = NULL;
+        bool full = tier->count == width;
+        if (full) {
+            overflow = TIER_SLOT(list, tier, width - 1);
+            tier->count--;
+        }
+        tier_insert(list, tier, offset, carry);
+        if (!full) break;
+        carry = overflow;
+    }
+
+    size_t n = list->size + 1;
+    if (n > width * width) {
+        tiered_rebuild(list, n, list->tiered.shift + 1);
+    }
+    return true;
+}
+
+/**
+ * Append only touches the last tier.
+ * AI Use: AI Assisted
+ */
+static bool tiered_append(List *list, void *data) {
+    return tiered_insert(list, list->size, data);
+}
+
+/**
+ * O(sqrt n) remove: closes the hole inside the tier, then pulls the first
+ * element of each later tier back into the previous one.
+ * AI Use: AI Assisted
+ */
+static bool tiered_remove(List *list, size_t index, void **out) {
+    size_t t = index >> list->tiered.shift;
+    Tier **tiers = list->tiered.tiers;
+    void *data = tier_remove(list, tiers[t], index & TIER_MASK(list));
+    for (++t; t < list->tiered.count; ++t) {
+        void *moved = tier_remove(list, tiers[t], 0);
+        Tier *prev = tiers[t - 1];
+        TIER_SLOT(list, prev, prev->count) = moved;
+        prev->count++;
+    }
+    Tier *last = tiers[list->tiered.count - 1];
+    if (last->count == 0) {
+        LIST_FREE(list, last, TIER_BYTES(TIER_WIDTH(list)));
+        list->tiered.count--;
+    }
+
+    size_t n = list->size - 1;
+    size_t width = TIER_WIDTH(list);
+    if (list->tiered.shift > TIERED_MIN_SHIFT && n < width * width / 16) {
+        tiered_rebuild(list, n, list->tiered.shift - 1);
+    }
+    *out = data;
+    return true;
+}
+
+/**
+ * O(1) indexed read: tier by shift, slot by mask.
+ * AI Use: AI Assisted
+ */
+static void *tiered_get(const List *list, size_t index) {
+    const Tier *tier = list->tiered.tiers[index >> list->tiered.shift];
+    return TIER_SLOT(list, tier, index & TIER_MASK(list));
+}
+
+/**
+ * Batched read: tier by shift, slot by mask, without a call per element.
+ * AI Use: AI Assisted
+ */
+static bool tiered_get_many(const List *list, const size_t *idx, size_t n, void **out) {
+    Tier *const *tiers = list->tiered.tiers;
+    size_t shift = list->tiered.shift;
+    for (size_t i = 0; i < n; ++i) {
+        const Tier *tier = tiers[idx[i] >> shift];
+        out[i] = TIER_SLOT(list, tier, idx[i] & TIER_MASK(list));
+    }
+    return true;
+}
+
+static bool tiered_visit(List *list, ListSlotFn fn, void *ctx, bool write) {
+    (void)write;
+    for (size_t t = 0; t < list->tiered.count; ++t) {
+        Tier *tier = list->tiered.tiers[t];
+        for (size_t i = 0; i < tier->count; ++i) {
+            if (!fn(&TIER_SLOT(list, tier, i), ctx)) return true;
+        }
+    }
+    return true;
+}
+
+const ListOps list_tiered_ops = {
+    .init = tiered_init,
+    .destroy = tiered_destroy,
+    .append = tiered_append,
+    .insert = tiered_insert,
+    .remove = tiered_remove,
+    .get = tiered_get,
+    .get_many = tiered_get_many,
+    .visit = tiered_visit,
+};
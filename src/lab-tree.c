@@ -0,0 +1,228 @@
+#include "lab-internal.h"
+
+/**
+ * Node of the size-augmented AVL tree behind LIST_TREE. The in-order position
+ * of a node is its list index; count is the number of nodes in its subtree.
+ */
+struct TreeNode {
+    struct TreeNode *left;
+    struct TreeNode *right;
+    void *data;
+    size_t count;
+    int height;
+};
+
+static size_t tree_count(const TreeNode *node) {
+    return node ? node->count : 0;
+}
+
+static int tree_height(const TreeNode *node) {
+    return node ? node->height : 0;
+}
+
+/**
+ * Recomputes count and height from the children.
+ * AI Use: AI Assisted
+ */
+static void tree_update(TreeNode *node) {
+    int lh = tree_height(node->left);
+    int rh = tree_height(node->right);
+    node->height = 1 + (lh > rh ? lh : rh);
+    node->count = 1 + tree_count(node->left) + tree_count(node->right);
+}
+
+static TreeNode *tree_rotate_right(TreeNode *node) {
+    TreeNode *pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    tree_update(node);
+    tree_update(pivot);
+    return pivot;
+}
+
+static TreeNode *tree_rotate_left(TreeNode *node) {
+    TreeNode *pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    tree_update(node);
+    tree_update(pivot);
+    return pivot;
+}
+
+/**
+ * Restores the AVL invariant at node after one of its subtrees changed
+ * height by at most one. Returns the new subtree root.
+ * AI Use: AI Assisted
+ */
+static TreeNode *tree_rebalance(TreeNode *node) {
+    tree_update(node);
+    int balance = tree_height(node->left) - tree_height(node->right);
+    if (balance > 1) {
+        if (tree_height(node->left->left) < tree_height(node->left->right)) {
+            node->left = tree_rotate_left(node->left);
+        }
+        return tree_rotate_right(node);
+    }
+    if (balance < -1) {
+        if (tree_height(node->right->right) < tree_height(node->right->left)) {
+            node->right = tree_rotate_right(node->right);
+        }
+        return tree_rotate_left(node);
+    }
+    return node;
+}
+
+/**
+ * Places fresh so that it ends up at in-order position index of the subtree.
+ * AI Use: AI Assisted
+ */
+static TreeNode *tree_insert_at(TreeNode *node, size_t index, TreeNode *fresh) {
+    if (!node) return fresh;
+    size_t left_count = tree_count(node->left);
+    if (index <= left_count) {
+        node->left = tree_insert_at(node->left, index, fresh);
+    } else {
+        node->right = tree_insert_at(node->right, index - left_count - 1, fresh);
+    }
+    return tree_rebalance(node);
+}
+
+/**
+ * Removes the node at in-order position index of the subtree and stores its
+ * data in *out. A node with two children takes over its successor's data and
+ * the successor node is the one released.
+ * AI Use: AI Assisted
+ */
+static TreeNode *tree_remove_at(const List *list, TreeNode *node, size_t index, void **out) {
+    size_t left_count = tree_count(node->left);
+    if (index < left_count) {
+        node->left = tree_remove_at(list, node->left, index, out);
+    } else if (index > left_count) {
+        node->right = tree_remove_at(list, node->right, index - left_count - 1, out);
+    } else {
+        *out = node->data;
+        if (!node->left || !node->right) {
+            TreeNode *child = node->left ? node->left : node->right;
+            LIST_FREE(list, node, sizeof(TreeNode));
+            return child;
+        }
+        void *successor;
+        node->right = tree_remove_at(list, node->right, 0, &successor);
+        node->data = successor;
+    }
+    return tree_rebalance(node);
+}
+
+/**
+ * Post-order release of a subtree. Recursion depth is bounded by the AVL height.
+ * AI Use: AI Assisted
+ */
+static void tree_free(const List *list, TreeNode *node, FreeFunc free_func) {
+    if (!node) return;
+    tree_free(list, node->left, free_func);
+    tree_free(list, node->right, free_func);
+    if (free_func && node->data) {
+        free_func(node->data);
+    }
+    LIST_FREE(list, node, sizeof(TreeNode));
+}
+
+/**
+ * An empty tree is just a NULL root.
+ * AI Use: AI Assisted
+ */
+static bool tree_init(List *list, const ListOptions *options) {
+    (void)options;
+    list->tree.root = NULL;
+    return true;
+}
+
+/**
+ * Frees every tree node, calling free_func on each element if provided.
+ * AI Use: AI Assisted
+ */
+static void tree_destroy(List *list, FreeFunc free_func) {
+    tree_free(list, list->tree.root, free_func);
+    list->tree.root = NULL;
+}
+
+/**
+ * O(log n) insert. The node is allocated before the tree is touched so a
+ * failed allocation leaves the list unchanged.
+ * AI Use: AI Assisted
+ */
+static bool tree_insert(List *list, size_t index, void *data) {
+    TreeNode *fresh = LIST_ALLOC(list, sizeof(TreeNode));
+    if (!fresh) return false;
+    fresh->left = NULL;
+    fresh->right = NULL;
+    fresh->data = data;
+    fresh->count = 1;
+    fresh->height = 1;
+    list->tree.root = tree_insert_at(list->tree.root, index, fresh);
+    return true;
+}
+
+/**
+ * Append is an insert at the last position.
+ * AI Use: AI Assisted
+ */
+static bool tree_append(List *list, void *data) {
+    return tree_insert(list, list->size, data);
+}
+
+/**
+ * O(log n) remove.
+ * AI Use: AI Assisted
+ */
+static bool tree_remove(List *list, size_t index, void **out) {
+    list->tree.root = tree_remove_at(list, list->tree.root, index, out);
+    return true;
+}
+
+/**
+ * O(log n) indexed read, descending by subtree counts.
+ * AI Use: AI Assisted
+ */
+static void *tree_get(const List *list, size_t index) {
+    const TreeNode *node = list->tree.root;
+    for (;;) {
+        size_t left_count = tree_count(node->left);
+        if (index < left_count) {
+            node = node->left;
+        } else if (index > left_count) {
+            index -= left_count + 1;
+            node = node->right;
+        } else {
+            return node->data;
+        }
+    }
+}
+
+/**
+ * In-order walk of a subtree; returns false once fn asked to stop.
+ * Recursion depth is bounded by the AVL height.
+ * AI Use: AI Assisted
+ */
+static bool tree_visit_node(TreeNode *node, ListSlotFn fn, void *ctx) {
+    if (!node) return true;
+    return tree_visit_node(node->left, fn, ctx)
+        && fn(&node->data, ctx)
+        && tree_visit_node(node->right, fn, ctx);
+}
+
+static bool tree_visit(List *list, ListSlotFn fn, void *ctx, bool write) {
+    (void)write;
+    (void)tree_visit_node(list->tree.root, fn, ctx);
+    return true;
+}
+
+const ListOps list_tree_ops = {
+    .init = tree_init,
+    .destroy = tree_destroy,
+    .append = tree_append,
+    .insert = tree_insert,
+    .remove = tree_remove,
+    .get = tree_get,
+    .visit = tree_visit,
+};
@@ -0,0 +1,391 @@
+#include "lab-internal.h"
+#include <string.h>
+
+/**
+ * Default chunk capacity: one 64-byte cache line of data pointers.
+ */
+#define UNROLLED_DEFAULT_CAPACITY (64 / sizeof(void *))
+
+/**
+ * Chunks must hold at least two elements so a full chunk can be split.
+ */
+#define UNROLLED_MIN_CAPACITY 2
+
+/**
+ * Chunk of an unrolled list. items has list->unrolled.capacity slots, of
+ * which the first count are in use.
+ */
+struct Chunk {
+    struct Chunk *prev;
+    struct Chunk *next;
+    size_t count;
+    void *items[];
+};
+
+#define CHUNK_BYTES(list) (sizeof(Chunk) + (list)->unrolled.capacity * sizeof(void *))
+
+/**
+ * Allocates an empty chunk sized for this list.
+ * AI Use: AI Assisted
+ */
+static Chunk *chunk_new(const List *list) {
+    Chunk *chunk = LIST_ALLOC(list, CHUNK_BYTES(list));
+    if (!chunk) return NULL;
+    chunk->prev = NULL;
+    chunk->next = NULL;
+    chunk->count = 0;
+    return chunk;
+}
+
+/**
+ * Links chunk into the chain right after pos (or as the only chunk if pos is NULL).
+ * AI Use: AI Assisted
+ */
+static void chunk_link_after(List *list, Chunk *pos, Chunk *chunk) {
+    chunk->prev = pos;
+    chunk->next = pos ? pos->next : NULL;
+    if (chunk->next) {
+        chunk->next->prev = chunk;
+    } else {
+        list->unrolled.tail = chunk;
+    }
+    if (pos) {
+        pos->next = chunk;
+    } else {
+        list->unrolled.head = chunk;
+    }
+}
+
+/**
+ * Unlinks chunk from the chain and frees it.
+ * AI Use: AI Assisted
+ */
+static void chunk_unlink(List *list, Chunk *chunk) {
+    if (chunk->prev) {
+        chunk->prev->next = chunk->next;
+    } else {
+        list->unrolled.head = chunk->next;
+    }
+    if (chunk->next) {
+        chunk->next->prev = chunk->prev;
+    } else {
+        list->unrolled.tail = chunk->prev;
+    }
+    LIST_FREE(list, chunk, CHUNK_BYTES(list));
+}
+
+/**
+ * Finds the chunk holding index and the offset inside it. Whole chunks are
+ * skipped by their counts, starting from whichever end of the list is closer.
+ * index must be < list->size.
+ * AI Use: AI Assisted
+ */
+static Chunk *unrolled_locate(const List *list, size_t index, size_t *offset) {
+    Chunk *chunk;
+    if (index < list->size / 2) {
+        chunk = list->unrolled.head;
+        while (index >= chunk->count) {
+            index -= chunk->count;
+            chunk = chunk->next;
+        }
+    } else {
+        size_t from_end = list->size - index; // 1-based distance from the end
+        chunk = list->unrolled.tail;
+        while (from_end > chunk->count) {
+            from_end -= chunk->count;
+            chunk = chunk->prev;
+        }
+        index = chunk->count - from_end;
+    }
+    *offset = index;
+    return chunk;
+}
+
+/**
+ * Reads the requested chunk capacity; an empty list has no chunks yet.
+ * AI Use: AI Assisted
+ */
+static bool unrolled_init(List *list, const ListOptions *options) {
+    size_t capacity = options ? options->chunk_capacity : 0;
+    if (capacity == 0) {
+        capacity = UNROLLED_DEFAULT_CAPACITY;
+    } else if (capacity < UNROLLED_MIN_CAPACITY) {
+        capacity = UNROLLED_MIN_CAPACITY;
+    }
+    list->unrolled.head = NULL;
+    list->unrolled.tail = NULL;
+    list->unrolled.capacity = capacity;
+    return true;
+}
+
+/**
+ * Frees every chunk, calling free_func on each element if provided.
+ * AI Use: AI Assisted
+ */
+static void unrolled_destroy(List *list, FreeFunc free_func) {
+    Chunk *chunk = list->unrolled.head;
+    while (chunk) {
+        Chunk *next = chunk->next;
+        if (free_func) {
+            for (size_t i = 0; i < chunk->count; ++i) {
+                if (chunk->items[i]) {
+                    free_func(chunk->items[i]);
+                }
+            }
+        }
+        LIST_FREE(list, chunk, CHUNK_BYTES(list));
+        chunk = next;
+    }
+    list->unrolled.head = NULL;
+    list->unrolled.tail = NULL;
+}
+
+/**
+ * Appends into the tail chunk, starting a fresh chunk when it is full so
+ * append-only lists end up with fully packed chunks.
+ * AI Use: AI Assisted
+ */
+static bool unrolled_append(List *list, void *data) {
+    Chunk *tail = list->unrolled.tail;
+    if (!tail || tail->count == list->unrolled.capacity) {
+        Chunk *chunk = chunk_new(list);
+        if (!chunk) return false;
+        chunk_link_after(list, tail, chunk);
+        tail = chunk;
+    }
+    tail->items[tail->count++] = data;
+    return true;
+}
+
+/**
+ * Inserts at offset *at_offset of chunk *at, splitting the chunk in half
+ * first when it is full. On return *at and *at_offset give where data landed.
+ * AI Use: AI Assisted
+ */
+static bool unrolled_insert_at(List *list, Chunk **at, size_t *at_offset, void *data) {
+    Chunk *chunk = *at;
+    size_t offset = *at_offset;
+    size_t capacity = list->unrolled.capacity;
+    if (chunk->count == capacity) {
+        Chunk *split = chunk_new(list);
+        if (!split) return false;
+        size_t keep = capacity / 2;
+        split->count = capacity - keep;
+        memcpy(split->items, &chunk->items[keep], split->count * sizeof(void *));
+        chunk->count = keep;
+        chunk_link_after(list, chunk, split);
+        if (offset > keep) {
+            chunk = split;
+            offset -= keep;
+        }
+    }
+
+    memmove(&chunk->items[offset + 1], &chunk->items[offset],
+            (chunk->count - offset) * sizeof(void *));
+    chunk->items[offset] = data;
+    chunk->count++;
+    *at = chunk;
+    *at_offset = offset;
+    return true;
+}
+
+/**
+ * Inserts inside the owning chunk.
+ * AI Use: AI Assisted
+ */
+static bool unrolled_insert(List *list, size_t index, void *data) {
+    if (index == list->size) {
+        return unrolled_append(list, data);
+    }
+    size_t offset;
+    Chunk *chunk = unrolled_locate(list, index, &offset);
+    return unrolled_insert_at(list, &chunk, &offset, data);
+}
+
+/**
+ * Removes chunk->items[offset] and keeps chunks at least half full by merging
+ * an underfull chunk with a neighbour whenever both fit in one chunk. Returns
+ * the element; *next and *next_offset receive the position of the one that
+ * followed it, which is (NULL, 0) at the end.
+ * AI Use: AI Assisted
+ */
+static void *unrolled_remove_at(List *list, Chunk *chunk, size_t offset,
+                                Chunk **next, size_t *next_offset) {
+    void *data = chunk->items[offset];
+    chunk->count--;
+    memmove(&chunk->items[offset], &chunk->items[offset + 1],
+            (chunk->count - offset) * sizeof(void *));
+
+    Chunk *at = chunk;
+    size_t pos = offset;
+    if (pos == chunk->count) {
+        at = chunk->next;
+        pos = 0;
+    }
+    size_t capacity = list->unrolled.capacity;
+    if (chunk->count == 0) {
+        chunk_unlink(list, chunk);
+    } else if (chunk->count < capacity / 2) {
+        Chunk *into = NULL;
+        Chunk *from = NULL;
+        if (chunk->next && chunk->count + chunk->next->count <= capacity) {
+            into = chunk;
+            from = chunk->next;
+        } else if (chunk->prev && chunk->prev->count + chunk->count <= capacity) {
+            into = chunk->prev;
+            from = chunk;
+        }
+        if (into) {
+            if (at == from) {
+                at = into;
+                pos += into->count;
+            }
+            memcpy(&into->items[into->count], from->items, from->count * sizeof(void *));
+            into->count += from->count;
+            chunk_unlink(list, from);
+        }
+    }
+    *next = at;
+    *next_offset = pos;
+    return data;
+}
+
+static bool unrolled_remove(List *list, size_t index, void **out) {
+    size_t offset;
+    Chunk *chunk = unrolled_locate(list, index, &offset);
+    Chunk *next;
+    size_t next_offset;
+    *out = unrolled_remove_at(list, chunk, offset, &next, &next_offset);
+    return true;
+}
+
+/**
+ * Indexed read that skips whole chunks.
+ * AI Use: AI Assisted
+ */
+static void *unrolled_get(const List *list, size_t index) {
+    size_t offset;
+    const Chunk *chunk = unrolled_locate(list, index, &offset);
+    return chunk->items[offset];
+}
+
+/**
+ * Batched read: sorts the indices and serves them in one pass over the chunks.
+ * AI Use: AI Assisted
+ */
+static bool unrolled_get_many(const List *list, const size_t *idx, size_t n, void **out) {
+    ListGather *order;
+    if (!list_gather_order(idx, n, &order)) return false;
+    const Chunk *chunk = list->unrolled.head;
+    size_t base = 0; // list index of chunk->items[0]
+    for (size_t i = 0; i < n; ++i) {
+        size_t index = order ? order[i].index : idx[i];
+        while (index >= base + chunk->count) {
+            base += chunk->count;
+            chunk = chunk->next;
+        }
+        out[order ? order[i].slot : i] = chunk->items[index - base];
+    }
+    list_gather_free(order);
+    return true;
+}
+
+/**
+ * Walks the chunk chain, prefetching the next chunk while the current one is visited.
+ * AI Use: AI Assisted
+ */
+static bool unrolled_visit(List *list, ListSlotFn fn, void *ctx, bool write) {
+    (void)write;
+    for (Chunk *chunk = list->unrolled.head; chunk; chunk = chunk->next) {
+        LAB_PREFETCH(chunk->next);
+        for (size_t i = 0; i < chunk->count; ++i) {
+            if (!fn(&chunk->items[i], ctx)) return true;
+        }
+    }
+    return true;
+}
+
+/**
+ * Cursor positions are a chunk and an offset into it; the end position is
+ * (NULL, 0), and stepping back from it lands on the tail chunk.
+ * AI Use: AI Assisted
+ */
+static void unrolled_cursor_seek(ListIter *it) {
+    if (it->index < it->list->size) {
+        it->node = unrolled_locate(it->list, it->index, &it->offset);
+    } else {
+        it->node = NULL;
+        it->offset = 0;
+    }
+}
+
+static void unrolled_cursor_next(ListIter *it) {
+    const Chunk *chunk = it->node;
+    if (++it->offset == chunk->count) {
+        it->node = chunk->next;
+        it->offset = 0;
+    }
+}
+
+static void unrolled_cursor_prev(ListIter *it) {
+    Chunk *chunk = it->node;
+    if (!chunk) {
+        chunk = it->list->unrolled.tail;
+        it->offset = chunk->count;
+    } else if (it->offset == 0) {
+        chunk = chunk->prev;
+        it->offset = chunk->count;
+    }
+    it->node = chunk;
+    it->offset--;
+}
+
+static void *unrolled_cursor_data(const ListIter *it) {
+    return ((const Chunk *)it->node)->items[it->offset];
+}
+
+/**
+ * Inserts in front of the cursor's element and moves the cursor to where
+ * that element ended up, which is the next chunk if a split put it there.
+ * AI Use: AI Assisted
+ */
+static bool unrolled_cursor_insert(ListIter *it, void *data) {
+    if (!it->node) return unrolled_append(it->list, data);
+    Chunk *chunk = it->node;
+    size_t offset = it->offset;
+    if (!unrolled_insert_at(it->list, &chunk, &offset, data)) return false;
+    it->node = chunk;
+    it->offset = offset;
+    unrolled_cursor_next(it);
+    return true;
+}
+
+static void *unrolled_cursor_remove(ListIter *it) {
+    Chunk *next;
+    size_t next_offset;
+    void *data = unrolled_remove_at(it->list, it->node, it->offset, &next, &next_offset);
+    it->node = next;
+    it->offset = next_offset;
+    return data;
+}
+
+static const ListCursorOps unrolled_cursor_ops = {
+    .seek = unrolled_cursor_seek,
+    .next = unrolled_cursor_next,
+    .prev = unrolled_cursor_prev,
+    .data = unrolled_cursor_data,
+    .insert_before = unrolled_cursor_insert,
+    .remove = unrolled_cursor_remove,
+};
+
+const ListOps list_unrolled_ops = {
+    .init = unrolled_init,
+    .destroy = unrolled_destroy,
+    .append = unrolled_append,
+    .insert = unrolled_insert,
+    .remove = unrolled_remove,
+    .get = unrolled_get,
+    .get_many = unrolled_get_many,
+    .visit = unrolled_visit,
+    .cursor = &unrolled_cursor_ops,
+};
@@ -1,6 +1,7 @@
-#include "lab.h"
+#include "lab-internal.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef ALLOC
 #define ALLOC(size) malloc(size)
@@ -17,41 +18,119 @@ AllocFn lab_alloc_fn = NULL;
 FreeFn  lab_free_fn  = NULL;
 
 /**
- * Node structure for the circular, doubly linked list.
+ * Default per-list allocator: forwards to ALLOC / DESTROY and thus to the
+ * global hooks above (or the compile-time allocator), so lists created
+ * without an allocator behave as before.
  * AI Use: AI Assisted
  */
-typedef struct Node {
-    void *data;
-    struct Node *prev;
-    struct Node *next;
-} Node;
+void *lab_default_alloc(void *ctx, size_t size) {
+    (void)ctx;
+    return ALLOC(size);
+}
+
+void lab_default_free(void *ctx, void *ptr) {
+    (void)ctx;
+    DESTROY(ptr);
+}
+
+static const ListAllocator default_allocator = {
+    .alloc = lab_default_alloc,
+    .free = lab_default_free,
+    .ctx = NULL,
+};
 
 /**
- * List structure definition for the circular, doubly linked list with sentinel node.
- * AI Use: AI Assisted
+ * Default cap on the number of nodes per slab (6 KiB of nodes on LP64).
  */
-struct List {
-    size_t size;
-    ListType type;
-    Node *sentinel;
+#define SENTINEL_SLAB_NODES 256
+
+/**
+ * A block of nodes owned by one list. Slabs are only released by list_destroy.
+ */
+struct NodeSlab {
+    struct NodeSlab *next;
+    size_t count;               // nodes in this slab
+    Node nodes[];
 };
 
+#define NODE_SLAB_BYTES(count) (sizeof(NodeSlab) + (count) * sizeof(Node))
+
+/**
+ * Bytes of a checkpoint array (list_enable_index) with room for capacity nodes.
+ */
+#define CHECKPOINT_BYTES(capacity) ((capacity) * sizeof(Node *))
+
 /**
- * Creates a new circular, doubly linked list with a sentinel node.
+ * Allocates a slab of count nodes and pushes them onto the free list so that
+ * they are handed out in address order.
  * AI Use: AI Assisted
  */
-List *list_create(ListType type) {
-    // Allocate memory for the list
-    List *list = ALLOC(sizeof(List));
-    if (list == NULL) {
-        return NULL; // allocation failed
+static bool sentinel_add_slab(List *list, size_t count) {
+    SentinelState *s = &list->linked;
+    if (count > (SIZE_MAX - sizeof(NodeSlab)) / sizeof(Node)) return false;
+    NodeSlab *slab = LIST_ALLOC(list, NODE_SLAB_BYTES(count));
+    if (!slab) return false;
+    slab->count = count;
+    slab->next = s->slabs;
+    s->slabs = slab;
+    for (size_t i = count; i-- > 0;) {
+        slab->nodes[i].next = s->free_nodes;
+        s->free_nodes = &slab->nodes[i];
+    }
+    s->free_count += count;
+    return true;
+}
+
+/**
+ * Pops a node off the list's free list, first carving a new slab when it is
+ * empty. Slabs double in size up to slab_max, so a list of n nodes makes
+ * O(log n) allocations before it reaches the cap and one per slab_max after.
+ * Thread-cache lists only keep nodes here that list_reserve set aside.
+ * AI Use: AI Assisted
+ */
+static Node *sentinel_node_alloc(List *list) {
+    SentinelState *s = &list->linked;
+    if (!s->free_nodes) {
+        if (s->thread_cache) {
+            if (!list_mem_admit(list, sizeof(Node))) return NULL;
+            Node *node = node_cache_alloc();
+            if (node) list_mem_charge(list, sizeof(Node));
+            return node;
+        }
+        if (!sentinel_add_slab(list, s->slab_next)) return NULL;
+        if (s->slab_next < s->slab_max) {
+            s->slab_next = s->slab_next * 2 < s->slab_max ? s->slab_next * 2 : s->slab_max;
+        }
     }
+    Node *node = s->free_nodes;
+    s->free_nodes = node->next;
+    s->free_count--;
+    return node;
+}
+
+/**
+ * Returns an unlinked node to the free list (or the thread cache) for reuse.
+ */
+static void sentinel_node_free(List *list, Node *node) {
+    if (list->linked.thread_cache) {
+        node_cache_free(node);
+        list_mem_credit(list, sizeof(Node));
+        return;
+    }
+    node->next = list->linked.free_nodes;
+    list->linked.free_nodes = node;
+    list->linked.free_count++;
+}
 
+/**
+ * Allocates the sentinel node for a circular, doubly linked list.
+ * AI Use: AI Assisted
+ */
+static bool sentinel_init(List *list, const ListOptions *options) {
     // Allocate memory for the sentinel node
-    Node *sentinel = ALLOC(sizeof(Node));
+    Node *sentinel = LIST_ALLOC(list, sizeof(Node));
     if (sentinel == NULL) {
-    DESTROY(list);
-        return NULL;
+        return false;
     }
 
     // Initialize the sentinel node (circular self-links)
@@ -59,45 +138,88 @@ List *list_create(ListType type) {
     sentinel->next = sentinel;
     sentinel->prev = sentinel;
 
-    // Initialize the list
-    list->size = 0;
-    list->type = type;
-    list->sentinel = sentinel;
-
-    return list;
+    size_t slab_max = options ? options->slab_nodes : 0;
+    ListNodeSource source = options ? options->node_source : LIST_NODES_DEFAULT;
+    if (source == LIST_NODES_DEFAULT) {
+        source = node_cache_default_source();
+    }
+    list->linked.sentinel = sentinel;
+    // The cache outlives any one list, so it can only serve the global hooks
+    list->linked.thread_cache = source == LIST_NODES_THREAD_CACHE && list->default_alloc;
+    list->linked.slabs = NULL;
+    list->linked.free_nodes = NULL;
+    list->linked.free_count = 0;
+    list->linked.slab_next = 1;
+    list->linked.slab_max = slab_max ? slab_max : SENTINEL_SLAB_NODES;
+    list->linked.finger = NULL;
+    list->linked.finger_index = 0;
+    list->linked.checkpoints = NULL;
+    list->linked.checkpoint_count = 0;
+    list->linked.checkpoint_capacity = 0;
+    list->linked.stride = 0;
+    return true;
 }
 
 /**
- * Destroys the list and frees all associated memory. Calls free_func on each data element if provided.
+ * Frees the slabs and the sentinel. Nodes are only walked when free_func has
+ * to be called on each data element or they go back to the thread cache.
  * AI Use: AI Assisted
  */
-void list_destroy(List *list, FreeFunc free_func) {
-    if (!list) return;
-    Node *sentinel = list->sentinel;
-    Node *curr = sentinel->next;
-    while (curr != sentinel) {
-        Node *next = curr->next;
-        if (free_func && curr->data) {
-            free_func(curr->data);
+static void sentinel_destroy(List *list, FreeFunc free_func) {
+    Node *sentinel = list->linked.sentinel;
+    if (free_func || list->linked.thread_cache) {
+        Node *curr = sentinel->next;
+        while (curr != sentinel) {
+            Node *next = curr->next;
+            if (free_func && curr->data) {
+                free_func(curr->data);
+            }
+            if (list->linked.thread_cache) {
+                node_cache_free(curr);
+                list_mem_credit(list, sizeof(Node));
+            }
+            curr = next;
         }
-        DESTROY(curr);
-        curr = next;
     }
-    DESTROY(sentinel);
-    DESTROY(list);
+    if (list->linked.thread_cache) { // nodes set aside by list_reserve
+        Node *node = list->linked.free_nodes;
+        while (node) {
+            Node *next = node->next;
+            node_cache_free(node);
+            list_mem_credit(list, sizeof(Node));
+            node = next;
+        }
+    }
+    NodeSlab *slab = list->linked.slabs;
+    while (slab) {
+        NodeSlab *next = slab->next;
+        LIST_FREE(list, slab, NODE_SLAB_BYTES(slab->count));
+        slab = next;
+    }
+    if (list->linked.checkpoints) {
+        LIST_FREE(list, list->linked.checkpoints, CHECKPOINT_BYTES(list->linked.checkpoint_capacity));
+    }
+    LIST_FREE(list, sentinel, sizeof(Node));
+    list->linked.sentinel = NULL;
+    list->linked.checkpoints = NULL;
+    list->linked.checkpoint_capacity = 0;
+    list->linked.checkpoint_count = 0;
+    list->linked.slabs = NULL;
+    list->linked.free_nodes = NULL;
+    list->linked.free_count = 0;
+    list->linked.finger = NULL;
 }
 
 /**
- * Appends a new element to the end of the list.
+ * Appends a new node before the sentinel.
  * AI Use: AI Assisted
  */
-bool list_append(List *list, void *data) {
-    if (!list || !list->sentinel) return false;
-    Node *new_node = ALLOC(sizeof(Node));
+static bool sentinel_append(List *list, void *data) {
+    Node *new_node = sentinel_node_alloc(list);
     if (!new_node) return false;
     new_node->data = data;
 
-    Node *sentinel = list->sentinel;
+    Node *sentinel = list->linked.sentinel;
     Node *last = sentinel->prev;
 
     // Insert new_node before sentinel
@@ -105,35 +227,659 @@ bool list_append(List *list, void *data) {
     new_node->prev = last;
     last->next = new_node;
     sentinel->prev = new_node;
-
-    list->size++;
     return true;
 }
 
 /**
- * Inserts a new element at the specified index in the list.
+ * Makes checkpoints[0..j] valid, growing the array if needed and walking on
+ * from the last valid checkpoint. j * stride must be < size. Returns false
+ * (and leaves the index as it was) if the array cannot grow.
  * AI Use: AI Assisted
  */
-bool list_insert(List *list, size_t index, void *data) {
-    if (!list || !list->sentinel) return false;
-    if (index > list->size) return false; // index out of bounds
+static bool sentinel_index_extend(List *list, size_t j) {
+    SentinelState *s = &list->linked;
+    if (j >= s->checkpoint_capacity) {
+        size_t capacity = s->checkpoint_capacity ? s->checkpoint_capacity : 16;
+        while (capacity <= j) capacity *= 2;
+        Node **grown = LIST_ALLOC(list, CHECKPOINT_BYTES(capacity));
+        if (!grown) return false;
+        if (s->checkpoints) {
+            memcpy(grown, s->checkpoints, s->checkpoint_count * sizeof(Node *));
+            LIST_FREE(list, s->checkpoints, CHECKPOINT_BYTES(s->checkpoint_capacity));
+        }
+        s->checkpoints = grown;
+        s->checkpoint_capacity = capacity;
+    }
+    if (s->checkpoint_count == 0) {
+        s->checkpoints[s->checkpoint_count++] = s->sentinel->next;
+    }
+    Node *curr = s->checkpoints[s->checkpoint_count - 1];
+    while (s->checkpoint_count <= j) {
+        for (size_t i = 0; i < s->stride; ++i) curr = curr->next;
+        s->checkpoints[s->checkpoint_count++] = curr;
+    }
+    return true;
+}
 
-    Node *sentinel = list->sentinel;
-    Node *curr = sentinel->next;
-    for (size_t i = 0; i < index; ++i) {
-        curr = curr->next;
+/**
+ * An insert or remove at index shifts every node from index on, so only the
+ * checkpoints in front of it stay valid. The rest are rebuilt on demand.
+ */
+static void sentinel_index_truncate(List *list, size_t index) {
+    SentinelState *s = &list->linked;
+    if (s->stride == 0) return;
+    size_t valid = (index + s->stride - 1) / s->stride;
+    if (valid < s->checkpoint_count) s->checkpoint_count = valid;
+}
+
+/**
+ * Finds the node at index (index == size yields the sentinel) by walking
+ * from whichever is closest: the head, the tail or the finger, and, when
+ * those are more than a stride away and list_enable_index is on, the
+ * checkpoint at or before index. The node found becomes the new finger, so
+ * sequential and near-sequential access is O(1) amortized. Indexed reads
+ * update the finger (and may extend the index) too, which is why concurrent
+ * list_get calls on one sentinel list need external synchronization.
+ * AI Use: AI Assisted
+ */
+static Node *sentinel_node_at(const List *list, size_t index) {
+    List *self = (List *)list; // seek state only; the list itself is never const
+    SentinelState *s = &self->linked;
+    size_t from_tail = list->size - index;
+    Node *curr = s->sentinel->next;
+    size_t at = 0;
+    size_t best = index;
+    if (s->finger) {
+        size_t fi = s->finger_index;
+        size_t from_finger = index > fi ? index - fi : fi - index;
+        if (from_finger < best) {
+            curr = s->finger;
+            at = fi;
+            best = from_finger;
+        }
+    }
+    if (from_tail < best) {
+        curr = s->sentinel;
+        at = list->size;
+        best = from_tail;
+    }
+    if (best > s->stride && s->stride && index < list->size) {
+        size_t j = index / s->stride;
+        if (j < s->checkpoint_count || sentinel_index_extend(self, j)) {
+            curr = s->checkpoints[j];
+            at = j * s->stride;
+        }
     }
+    for (; at < index; ++at) curr = curr->next;
+    for (; at > index; --at) curr = curr->prev;
+    if (curr != s->sentinel) {
+        s->finger = curr;
+        s->finger_index = index;
+    }
+    return curr;
+}
 
-    Node *new_node = ALLOC(sizeof(Node));
+/**
+ * Links a new node in before pos.
+ * AI Use: AI Assisted
+ */
+static bool sentinel_insert_before(List *list, Node *pos, void *data) {
+    Node *new_node = sentinel_node_alloc(list);
     if (!new_node) return false;
     new_node->data = data;
 
-    // Insert new_node before curr
-    new_node->prev = curr->prev;
-    new_node->next = curr;
-    curr->prev->next = new_node;
-    curr->prev = new_node;
+    new_node->prev = pos->prev;
+    new_node->next = pos;
+    pos->prev->next = new_node;
+    pos->prev = new_node;
+    return true;
+}
+
+/**
+ * Unlinks node, recycles it and returns the node that followed it.
+ * AI Use: AI Assisted
+ */
+static Node *sentinel_unlink(List *list, Node *node, void **out) {
+    Node *next = node->next;
+    *out = node->data;
+    node->prev->next = next;
+    next->prev = node->prev;
+    sentinel_node_free(list, node);
+    return next;
+}
+
+/**
+ * Inserts a new node at the specified index; it becomes the finger.
+ * AI Use: AI Assisted
+ */
+static bool sentinel_insert(List *list, size_t index, void *data) {
+    Node *pos = sentinel_node_at(list, index);
+    if (!sentinel_insert_before(list, pos, data)) return false;
+    list->linked.finger = pos->prev; // the new node
+    list->linked.finger_index = index;
+    sentinel_index_truncate(list, index);
+    return true;
+}
+
+/**
+ * Unlinks the node at the specified index, recycles it and returns its data
+ * pointer. Its successor moves up into index and becomes the finger.
+ * AI Use: AI Assisted
+ */
+static bool sentinel_remove(List *list, size_t index, void **out) {
+    Node *next = sentinel_unlink(list, sentinel_node_at(list, index), out);
+    list->linked.finger = next != list->linked.sentinel ? next : NULL;
+    list->linked.finger_index = index;
+    sentinel_index_truncate(list, index);
+    return true;
+}
+
+/**
+ * Seeks to the specified index from the nearest end or the finger.
+ * AI Use: AI Assisted
+ */
+static void *sentinel_get(const List *list, size_t index) {
+    return sentinel_node_at(list, index)->data;
+}
+
+/**
+ * Sets aside enough free nodes for the list to grow to n elements: one
+ * contiguous slab, or nodes taken from the thread cache for cache lists
+ * (those can be returned to the cache one by one, so they cannot share a slab).
+ * AI Use: AI Assisted
+ */
+static bool sentinel_reserve(List *list, size_t n) {
+    SentinelState *s = &list->linked;
+    size_t missing = n - list->size - s->free_count;
+    if (!s->thread_cache) {
+        return sentinel_add_slab(list, missing);
+    }
+    for (; missing > 0; --missing) {
+        if (!list_mem_admit(list, sizeof(Node))) return false;
+        Node *node = node_cache_alloc();
+        if (!node) return false;
+        list_mem_charge(list, sizeof(Node));
+        node->next = s->free_nodes;
+        s->free_nodes = node;
+        s->free_count++;
+    }
+    return true;
+}
+
+static size_t sentinel_capacity(const List *list) {
+    return list->size + list->linked.free_count;
+}
+
+/**
+ * Copies every node into one new slab in logical order and relinks them, so a
+ * traversal walks memory front to back. All previous slabs (and spare nodes)
+ * are released; thread-cache nodes go back to the cache and the list owns its
+ * nodes from then on. On allocation failure the list is left as it was.
+ * AI Use: AI Assisted
+ */
+static bool sentinel_compact(List *list) {
+    SentinelState *s = &list->linked;
+    NodeSlab *slab = NULL;
+    if (list->size > 0) {
+        if (list->size > (SIZE_MAX - sizeof(NodeSlab)) / sizeof(Node)) return false;
+        slab = LIST_ALLOC(list, NODE_SLAB_BYTES(list->size));
+        if (!slab) return false;
+        slab->next = NULL;
+        slab->count = list->size;
+    }
+
+    Node *sentinel = s->sentinel;
+    Node *prev = sentinel;
+    Node *curr = sentinel->next;
+    for (size_t i = 0; curr != sentinel; ++i) {
+        Node *next = curr->next;
+        Node *node = &slab->nodes[i];
+        node->data = curr->data;
+        node->prev = prev;
+        prev->next = node;
+        prev = node;
+        if (s->thread_cache) {
+            node_cache_free(curr);
+            list_mem_credit(list, sizeof(Node));
+        }
+        curr = next;
+    }
+    prev->next = sentinel;
+    sentinel->prev = prev;
+
+    if (s->thread_cache) {
+        while (s->free_nodes) {
+            Node *next = s->free_nodes->next;
+            node_cache_free(s->free_nodes);
+            list_mem_credit(list, sizeof(Node));
+            s->free_nodes = next;
+        }
+        s->thread_cache = false;
+    }
+    NodeSlab *old = s->slabs;
+    while (old) {
+        NodeSlab *next = old->next;
+        LIST_FREE(list, old, NODE_SLAB_BYTES(old->count));
+        old = next;
+    }
+    s->slabs = slab;
+    s->free_nodes = NULL;
+    s->free_count = 0;
+    s->finger = NULL; // its node was moved, and so were the checkpoints
+    s->checkpoint_count = 0;
+    return true;
+}
+
+/**
+ * Serves the batch in index order, so each seek starts from the finger left
+ * by the previous one and the whole batch is one forward pass (or shorter,
+ * when the tail or a checkpoint is closer).
+ * AI Use: AI Assisted
+ */
+static bool sentinel_get_many(const List *list, const size_t *idx, size_t n, void **out) {
+    ListGather *order;
+    if (!list_gather_order(idx, n, &order)) return false;
+    for (size_t i = 0; i < n; ++i) {
+        size_t index = order ? order[i].index : idx[i];
+        out[order ? order[i].slot : i] = sentinel_node_at(list, index)->data;
+    }
+    list_gather_free(order);
+    return true;
+}
+
+/**
+ * Walks the ring of nodes, prefetching the node after the next one so its
+ * cache miss overlaps with the callback on the current one.
+ * AI Use: AI Assisted
+ */
+static bool sentinel_visit(List *list, ListSlotFn fn, void *ctx, bool write) {
+    (void)write;
+    Node *sentinel = list->linked.sentinel;
+    for (Node *curr = sentinel->next; curr != sentinel;) {
+        Node *next = curr->next;
+        LAB_PREFETCH(next->next);
+        if (!fn(&curr->data, ctx)) break;
+        curr = next;
+    }
+    return true;
+}
 
+/**
+ * Turns the checkpoint index on (stride k) or off (k == 0, which frees it).
+ * Changing the stride only drops the checkpoints; they are rebuilt lazily.
+ * AI Use: AI Assisted
+ */
+static bool sentinel_enable_index(List *list, size_t k) {
+    SentinelState *s = &list->linked;
+    if (k == 0 && s->checkpoints) {
+        LIST_FREE(list, s->checkpoints, CHECKPOINT_BYTES(s->checkpoint_capacity));
+        s->checkpoints = NULL;
+        s->checkpoint_capacity = 0;
+    }
+    s->stride = k;
+    s->checkpoint_count = 0;
+    return true;
+}
+
+static void sentinel_cursor_seek(ListIter *it) {
+    it->node = sentinel_node_at(it->list, it->index);
+}
+
+static void sentinel_cursor_next(ListIter *it) {
+    it->node = ((const Node *)it->node)->next;
+}
+
+static void sentinel_cursor_prev(ListIter *it) {
+    it->node = ((const Node *)it->node)->prev;
+}
+
+static void *sentinel_cursor_data(const ListIter *it) {
+    return ((const Node *)it->node)->data;
+}
+
+/**
+ * Cursor edits do not know their index, so the finger and the whole
+ * checkpoint index are dropped.
+ */
+static bool sentinel_cursor_insert(ListIter *it, void *data) {
+    List *list = it->list;
+    if (!sentinel_insert_before(list, it->node, data)) return false;
+    list->linked.finger = NULL;
+    list->linked.checkpoint_count = 0;
+    return true;
+}
+
+static void *sentinel_cursor_remove(ListIter *it) {
+    List *list = it->list;
+    void *data;
+    list->linked.finger = NULL;
+    list->linked.checkpoint_count = 0;
+    it->node = sentinel_unlink(list, it->node, &data);
+    return data;
+}
+
+static const ListCursorOps sentinel_cursor_ops = {
+    .seek = sentinel_cursor_seek,
+    .next = sentinel_cursor_next,
+    .prev = sentinel_cursor_prev,
+    .data = sentinel_cursor_data,
+    .insert_before = sentinel_cursor_insert,
+    .remove = sentinel_cursor_remove,
+};
+
+const ListOps list_sentinel_ops = {
+    .init = sentinel_init,
+    .destroy = sentinel_destroy,
+    .append = sentinel_append,
+    .insert = sentinel_insert,
+    .remove = sentinel_remove,
+    .get = sentinel_get,
+    .reserve = sentinel_reserve,
+    .capacity = sentinel_capacity,
+    .compact = sentinel_compact,
+    .cursor = &sentinel_cursor_ops,
+    .enable_index = sentinel_enable_index,
+    .get_many = sentinel_get_many,
+    .visit = sentinel_visit,
+};
+
+/**
+ * Maps a ListType to its backend operations, or NULL for an unknown type.
+ * AI Use: AI Assisted
+ */
+static const ListOps *list_ops_for(ListType type) {
+    switch (type) {
+    case LIST_LINKED_SENTINEL:
+        return &list_sentinel_ops;
+    case LIST_ARRAY:
+        return &list_array_ops;
+    case LIST_UNROLLED:
+        return &list_unrolled_ops;
+    case LIST_TREE:
+        return &list_tree_ops;
+    case LIST_SKIP:
+        return &list_skip_ops;
+    case LIST_RING:
+        return &list_ring_ops;
+    case LIST_BTREE:
+        return &list_btree_ops;
+    case LIST_GAP:
+        return &list_gap_ops;
+    case LIST_TIERED:
+        return &list_tiered_ops;
+    case LIST_ADAPTIVE:
+        return &list_adaptive_ops;
+    }
+    return NULL;
+}
+
+/**
+ * Creates a new list backed by the implementation selected by type.
+ * AI Use: AI Assisted
+ */
+List *list_create(ListType type) {
+    return list_create_with_options(type, NULL);
+}
+
+/**
+ * Shared constructor: the List itself is the first allocation made through
+ * allocator, then the backend sets up its own state.
+ * AI Use: AI Assisted
+ */
+static List *list_create_common(ListType type, const ListOptions *options,
+                                const ListAllocator *allocator) {
+    const ListOps *ops = list_ops_for(type);
+    if (ops == NULL) {
+        return NULL; // unknown list type
+    }
+
+    // Allocate memory for the list
+    List *list = allocator->alloc(allocator->ctx, sizeof(List));
+    if (list == NULL) {
+        return NULL; // allocation failed
+    }
+
+    // Initialize the list, then let the backend set up its own state
+    list->size = 0;
+    list->type = type;
+    list->ops = ops;
+    list->allocator = *allocator;
+    list->default_alloc = allocator->alloc == lab_default_alloc;
+    list->arena.chunk_size = 0;
+#ifndef LAB_NO_MEMORY_STATS
+    list->mem = (ListMemStats){ 0 };
+    list_mem_charge(list, sizeof(List));
+    list->mem_limit = SIZE_MAX;
+    list->limit_policy = LIST_LIMIT_FAIL;
+    list->evict_func = NULL;
+    list->limit_hit = false;
+#endif
+    if (options && options->arena_chunk && !list_arena_init(list, options->arena_chunk)) {
+        allocator->free(allocator->ctx, list);
+        return NULL;
+    }
+    if (!ops->init(list, options)) {
+        if (list->arena.chunk_size) {
+            list_arena_release(list);
+        }
+        allocator->free(allocator->ctx, list);
+        return NULL;
+    }
+
+    return list;
+}
+
+/**
+ * Creates a new list and passes the tuning options through to its backend.
+ * AI Use: AI Assisted
+ */
+List *list_create_with_options(ListType type, const ListOptions *options) {
+    return list_create_common(type, options, &default_allocator);
+}
+
+/**
+ * Creates a new list that allocates through the given allocator.
+ * AI Use: AI Assisted
+ */
+List *list_create_with_allocator(ListType type, const ListAllocator *allocator) {
+    if (allocator == NULL) {
+        allocator = &default_allocator;
+    } else if (!allocator->alloc || !allocator->free) {
+        return NULL;
+    }
+    return list_create_common(type, NULL, allocator);
+}
+
+/**
+ * Destroys the list and frees all associated memory. Calls free_func on each data element if provided.
+ * AI Use: AI Assisted
+ */
+void list_destroy(List *list, FreeFunc free_func) {
+    if (!list) return;
+    if (list->arena.chunk_size == 0) {
+        list->ops->destroy(list, free_func);
+    } else {
+        if (free_func) {
+            list->ops->destroy(list, free_func); // frees are no-ops, this only visits elements
+        }
+        list_arena_release(list);
+    }
+    ListAllocator allocator = list->allocator;
+    allocator.free(allocator.ctx, list);
+}
+
+/**
+ * Returns a new list handle that shares all of its structure with list.
+ * Only backends with copy-on-write nodes support this.
+ * AI Use: AI Assisted
+ */
+List *list_snapshot(const List *list) {
+    if (!list || !list->ops->share) return NULL;
+    if (list->arena.chunk_size) return NULL; // nodes die with this list's arena
+    List *copy = LIST_RAW_ALLOC(list, sizeof(List)); // charged to the copy below
+    if (copy == NULL) {
+        return NULL;
+    }
+    copy->size = list->size;
+    copy->type = list->type;
+    copy->ops = list->ops;
+    copy->allocator = list->allocator; // shared nodes may be freed by either handle
+    copy->default_alloc = list->default_alloc;
+    copy->arena.chunk_size = 0;
+#ifndef LAB_NO_MEMORY_STATS
+    copy->mem = (ListMemStats){ 0 };
+    list_mem_charge(copy, sizeof(List));
+    copy->mem_limit = SIZE_MAX;
+    copy->limit_policy = LIST_LIMIT_FAIL;
+    copy->evict_func = NULL;
+    copy->limit_hit = false;
+#endif
+    list->ops->share(copy, list);
+    return copy;
+}
+
+/**
+ * Preallocates room for n elements on backends that support it.
+ * AI Use: AI Assisted
+ */
+bool list_reserve(List *list, size_t n) {
+    if (!list || !list->ops->reserve) return false;
+    if (n <= list->ops->capacity(list)) return true;
+    return list->ops->reserve(list, n);
+}
+
+/**
+ * Returns how many elements the list can hold before it next allocates.
+ * AI Use: AI Assisted
+ */
+size_t list_capacity(const List *list) {
+    if (!list) return 0;
+    if (!list->ops->capacity) return list->size;
+    return list->ops->capacity(list);
+}
+
+/**
+ * Relays the list out for sequential traversal on backends that support it.
+ * AI Use: AI Assisted
+ */
+bool list_compact(List *list) {
+    if (!list || !list->ops->compact) return false;
+    return list->ops->compact(list);
+}
+
+/**
+ * Turns the sparse seek index on or off on backends that have one.
+ * AI Use: AI Assisted
+ */
+bool list_enable_index(List *list, size_t k) {
+    if (!list || !list->ops->enable_index) return false;
+    return list->ops->enable_index(list, k);
+}
+
+/**
+ * Copies the allocation counters kept by LIST_ALLOC / LIST_FREE.
+ * AI Use: AI Assisted
+ */
+bool list_memory_stats(const List *list, ListMemStats *stats) {
+#ifdef LAB_NO_MEMORY_STATS
+    (void)list;
+    (void)stats;
+    return false;
+#else
+    if (!list || !stats) return false;
+    *stats = list->mem;
+    return true;
+#endif
+}
+
+/**
+ * Sets the byte budget enforced by list_mem_admit.
+ * AI Use: AI Assisted
+ */
+bool list_set_memory_limit(List *list, size_t bytes, ListLimitPolicy policy, FreeFunc evict) {
+#ifdef LAB_NO_MEMORY_STATS
+    (void)list;
+    (void)bytes;
+    (void)policy;
+    (void)evict;
+    return false;
+#else
+    if (!list) return false;
+    list->mem_limit = bytes ? bytes : SIZE_MAX;
+    list->limit_policy = policy;
+    list->evict_func = evict;
+    list->limit_hit = false;
+    return true;
+#endif
+}
+
+/**
+ * Called after an append or insert failed. If the memory limit refused an
+ * allocation and the list evicts, drops the head element (moving *index
+ * along with it) and returns true so the caller retries. Only reached on
+ * failure, so successful edits never pay for it.
+ * AI Use: AI Assisted
+ */
+static bool list_evict_for_limit(List *list, size_t *index) {
+#ifdef LAB_NO_MEMORY_STATS
+    (void)list;
+    (void)index;
+    return false;
+#else
+    bool hit = list->limit_hit;
+    list->limit_hit = false;
+    if (!hit || list->limit_policy != LIST_LIMIT_EVICT_HEAD || list->size == 0) return false;
+    void *data = NULL;
+    if (!list->ops->remove(list, 0, &data)) return false;
+    list->size--;
+    if (*index > 0) (*index)--;
+    if (list->evict_func && data) {
+        list->evict_func(data);
+    }
+    return true;
+#endif
+}
+
+/**
+ * Forgets refusals from earlier calls (a failed list_reserve, a skipped
+ * rebuild), so list_evict_for_limit only reacts to the attempt that follows.
+ */
+static void list_limit_clear(List *list) {
+#ifdef LAB_NO_MEMORY_STATS
+    (void)list;
+#else
+    list->limit_hit = false;
+#endif
+}
+
+/**
+ * Appends a new element to the end of the list.
+ * AI Use: AI Assisted
+ */
+bool list_append(List *list, void *data) {
+    if (!list) return false;
+    size_t index = list->size;
+    for (;;) {
+        list_limit_clear(list);
+        if (list->ops->append(list, data)) break;
+        if (!list_evict_for_limit(list, &index)) return false;
+    }
+    list->size++;
+    return true;
+}
+
+/**
+ * Inserts a new element at the specified index in the list.
+ * AI Use: AI Assisted
+ */
+bool list_insert(List *list, size_t index, void *data) {
+    if (!list) return false;
+    if (index > list->size) return false; // index out of bounds
+    for (;;) {
+        list_limit_clear(list);
+        if (list->ops->insert(list, index, data)) break;
+        if (!list_evict_for_limit(list, &index)) return false;
+    }
     list->size++;
     return true;
 }
@@ -143,17 +889,10 @@ bool list_insert(List *list, size_t index, void *data) {
  * AI Use: AI Assisted
  */
 void *list_remove(List *list, size_t index) {
-    if (!list || !list->sentinel) return NULL;
+    if (!list) return NULL;
     if (index >= list->size) return NULL;
-    Node *sentinel = list->sentinel;
-    Node *curr = sentinel->next;
-    for (size_t i = 0; i < index; ++i) {
-        curr = curr->next;
-    }
-    void *data = curr->data;
-    curr->prev->next = curr->next;
-    curr->next->prev = curr->prev;
-    DESTROY(curr);
+    void *data = NULL;
+    if (!list->ops->remove(list, index, &data)) return NULL;
     list->size--;
     return data;
 }
@@ -163,13 +902,252 @@ void *list_remove(List *list, size_t index) {
  * AI Use: AI Assisted
  */
 void *list_get(const List *list, size_t index) {
-    if (!list || !list->sentinel) return NULL;
+    if (!list) return NULL;
     if (index >= list->size) return NULL;
-    Node *curr = list->sentinel->next;
-    for (size_t i = 0; i < index; ++i) {
-        curr = curr->next;
+    return list->ops->get(list, index);
+}
+
+/**
+ * Fills in the backend position for it->index, or NULL on backends without
+ * cursor support (those are accessed by index).
+ * AI Use: AI Assisted
+ */
+static void list_iter_seek(List *list, ListIter *it, size_t index) {
+    const ListCursorOps *cursor = list->ops->cursor;
+    it->list = list;
+    it->index = index;
+    it->node = NULL;
+    it->offset = 0;
+    if (cursor) cursor->seek(it);
+}
+
+/**
+ * Starts a cursor on the first element.
+ * AI Use: AI Assisted
+ */
+bool list_iter_begin(List *list, ListIter *it) {
+    if (!list || !it) return false;
+    list_iter_seek(list, it, 0);
+    return list->size > 0;
+}
+
+/**
+ * Starts a cursor past the last element.
+ * AI Use: AI Assisted
+ */
+bool list_iter_end(List *list, ListIter *it) {
+    if (!list || !it) return false;
+    list_iter_seek(list, it, list->size);
+    return list->size > 0;
+}
+
+/**
+ * Steps forward by following the node link, or just by index.
+ * AI Use: AI Assisted
+ */
+bool list_iter_next(ListIter *it) {
+    if (!it || !it->list || it->index >= it->list->size) return false;
+    const ListCursorOps *cursor = it->list->ops->cursor;
+    if (cursor) {
+        cursor->next(it);
+    }
+    it->index++;
+    return it->index < it->list->size;
+}
+
+/**
+ * Steps back; the end position steps onto the last element.
+ * AI Use: AI Assisted
+ */
+bool list_iter_prev(ListIter *it) {
+    if (!it || !it->list || it->index == 0) return false;
+    const ListCursorOps *cursor = it->list->ops->cursor;
+    if (cursor) {
+        cursor->prev(it);
+    }
+    it->index--;
+    return true;
+}
+
+/**
+ * Reads the element under the cursor.
+ * AI Use: AI Assisted
+ */
+void *list_iter_get(const ListIter *it) {
+    if (!it || !it->list || it->index >= it->list->size) return NULL;
+    const ListCursorOps *cursor = it->list->ops->cursor;
+    if (cursor) {
+        return cursor->data(it);
+    }
+    return it->list->ops->get(it->list, it->index);
+}
+
+/**
+ * Inserts before the cursor. Goes straight to the backend, so a memory limit
+ * cannot evict the node the cursor stands on.
+ * AI Use: AI Assisted
+ */
+bool list_iter_insert(ListIter *it, void *data) {
+    if (!it || !it->list) return false;
+    List *list = it->list;
+    const ListCursorOps *cursor = list->ops->cursor;
+    if (cursor) {
+        if (!cursor->insert_before(it, data)) return false;
+    } else if (!list->ops->insert(list, it->index, data)) {
+        return false;
+    }
+    list->size++;
+    it->index++;
+    return true;
+}
+
+/**
+ * Removes the element under the cursor; the cursor moves onto its successor.
+ * AI Use: AI Assisted
+ */
+void *list_iter_remove(ListIter *it) {
+    if (!it || !it->list || it->index >= it->list->size) return NULL;
+    List *list = it->list;
+    const ListCursorOps *cursor = list->ops->cursor;
+    void *data = NULL;
+    if (cursor) {
+        data = cursor->remove(it);
+    } else if (!list->ops->remove(list, it->index, &data)) {
+        return NULL;
+    }
+    list->size--;
+    return data;
+}
+
+/**
+ * Orders qsort'ed gather requests by list position.
+ */
+static int list_gather_cmp(const void *a, const void *b) {
+    const ListGather *x = a;
+    const ListGather *y = b;
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+/**
+ * Sorts the requests of a batched get by index so linked backends can serve
+ * them in one forward pass. Already sorted input needs no scratch: *order is
+ * set to NULL and idx can be used as is. Returns false if the scratch array
+ * cannot be allocated. It is temporary, so it comes from ALLOC rather than
+ * the list's allocator (an arena would keep it until list_destroy).
+ * AI Use: AI Assisted
+ */
+bool list_gather_order(const size_t *idx, size_t n, ListGather **order) {
+    *order = NULL;
+    size_t i = 1;
+    while (i < n && idx[i - 1] <= idx[i]) ++i;
+    if (i >= n) return true;
+    if (n > SIZE_MAX / sizeof(ListGather)) return false;
+    ListGather *sorted = ALLOC(n * sizeof(ListGather));
+    if (!sorted) return false;
+    for (i = 0; i < n; ++i) {
+        sorted[i].index = idx[i];
+        sorted[i].slot = i;
+    }
+    qsort(sorted, n, sizeof(ListGather), list_gather_cmp);
+    *order = sorted;
+    return true;
+}
+
+void list_gather_free(ListGather *order) {
+    if (order) {
+        DESTROY(order);
+    }
+}
+
+/**
+ * Checks every index up front so a failed call leaves out untouched, then
+ * hands the batch to the backend, or reads the indices one by one.
+ * AI Use: AI Assisted
+ */
+bool list_get_many(const List *list, const size_t *idx, size_t n, void **out) {
+    if (!list) return false;
+    if (n == 0) return true;
+    if (!idx || !out) return false;
+    for (size_t i = 0; i < n; ++i) {
+        if (idx[i] >= list->size) return false;
     }
-    return curr->data;
+    if (list->ops->get_many) {
+        return list->ops->get_many(list, idx, n, out);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = list->ops->get(list, idx[i]);
+    }
+    return true;
+}
+
+/**
+ * Adapters from the public callbacks to ListSlotFn.
+ */
+typedef struct ForeachCtx {
+    ListVisitFn fn;
+    void *ctx;
+    size_t visited;
+} ForeachCtx;
+
+static bool foreach_slot(void **slot, void *ctx) {
+    ForeachCtx *f = ctx;
+    f->visited++;
+    return f->fn(*slot, f->ctx);
+}
+
+typedef struct MapCtx {
+    ListMapFn fn;
+    void *ctx;
+} MapCtx;
+
+static bool map_slot(void **slot, void *ctx) {
+    MapCtx *m = ctx;
+    *slot = m->fn(*slot, m->ctx);
+    return true;
+}
+
+typedef struct ReduceCtx {
+    ListReduceFn fn;
+    void *acc;
+    void *ctx;
+} ReduceCtx;
+
+static bool reduce_slot(void **slot, void *ctx) {
+    ReduceCtx *r = ctx;
+    r->acc = r->fn(r->acc, *slot, r->ctx);
+    return true;
+}
+
+/**
+ * Runs fn over every element through the backend's own traversal.
+ * AI Use: AI Assisted
+ */
+size_t list_foreach(const List *list, ListVisitFn fn, void *ctx) {
+    if (!list || !fn) return 0;
+    ForeachCtx f = { fn, ctx, 0 };
+    (void)list->ops->visit((List *)list, foreach_slot, &f, false); // read-only walk
+    return f.visited;
+}
+
+/**
+ * Stores fn(element) over every element through the backend's own traversal.
+ * AI Use: AI Assisted
+ */
+bool list_map_inplace(List *list, ListMapFn fn, void *ctx) {
+    if (!list || !fn) return false;
+    MapCtx m = { fn, ctx };
+    return list->ops->visit(list, map_slot, &m, true);
+}
+
+/**
+ * Folds the elements in order through the backend's own traversal.
+ * AI Use: AI Assisted
+ */
+void *list_reduce(const List *list, ListReduceFn fn, void *init, void *ctx) {
+    if (!list || !fn) return init;
+    ReduceCtx r = { fn, init, ctx };
+    (void)list->ops->visit((List *)list, reduce_slot, &r, false); // read-only walk
+    return r.acc;
 }
 
 /**
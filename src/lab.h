@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>   // for malloc, free.  
  #include <stdlib.h>   // malloc, free
 
@@ -12,6 +13,25 @@ typedef void (*FreeFn)(void *); //Function pointers
 extern AllocFn lab_alloc_fn; //golbal function pointer for custom allocation
 extern FreeFn  lab_free_fn; //golbal function pointer for custom free
 
+/*Compile-time binding (-DLAB_STATIC_ALLOCATOR, the release default).
+ALLOC/DESTROY call LAB_STATIC_ALLOC/LAB_STATIC_FREE directly (malloc/free
+unless defined; custom functions must be declared before this header, e.g.
+with -include) and the hooks above are never consulted.*/
+#ifdef LAB_STATIC_ALLOCATOR
+#  ifndef LAB_STATIC_ALLOC
+#    define LAB_STATIC_ALLOC malloc
+#  endif
+#  ifndef LAB_STATIC_FREE
+#    define LAB_STATIC_FREE free
+#  endif
+#  ifndef ALLOC
+#    define ALLOC(sz)   LAB_STATIC_ALLOC(sz)
+#  endif
+#  ifndef DESTROY
+#    define DESTROY(p)  LAB_STATIC_FREE(p)
+#  endif
+#endif
+
 /*is a macro wrapper around allocation.
 If lab_alloc_fn is set, call it (test hook).
 Otherwise call malloc(sz).*/
@@ -33,9 +53,78 @@ typedef struct List List;
  * @brief Enumeration for selecting the list implementation type.
  */
 typedef enum {
-    LIST_LINKED_SENTINEL
+    LIST_LINKED_SENTINEL,   /**< Circular, doubly linked list with a sentinel node. */
+    LIST_ARRAY,             /**< Contiguous dynamic array: O(1) get, amortized O(1) append. */
+    LIST_UNROLLED,          /**< Linked chunks of data pointers (see ListOptions::chunk_capacity). */
+    LIST_TREE,              /**< Order-statistic AVL tree: O(log n) get, insert and remove. */
+    LIST_SKIP,              /**< Indexable skip list: expected O(log n) get, insert and remove. */
+    LIST_RING,              /**< Circular buffer deque: O(1) get and O(1) push/pop at both ends. */
+    LIST_BTREE,             /**< Counted B+tree ("rope") with packed leaves: O(log n), high fan-out.
+                                 Persistent: supports O(1) list_snapshot. */
+    LIST_GAP,               /**< Gap buffer: O(1) get, O(1) amortized edits near the last edit. */
+    LIST_TIERED,            /**< Tiered vector of ~sqrt(n)-wide tiers: O(1) get, O(sqrt n) insert/remove. */
+    LIST_ADAPTIVE           /**< Switches between sentinel and array layouts based on the operation mix. */
 } ListType;
 
+/**
+ * @enum ListNodeSource
+ * @brief Where LIST_LINKED_SENTINEL lists get their nodes from.
+ */
+typedef enum {
+    LIST_NODES_DEFAULT = 0,     /**< Whatever list_set_default_node_source selected (initially slabs). */
+    LIST_NODES_SLAB,            /**< Per-list slabs, released by list_destroy (see ListOptions::slab_nodes). */
+    LIST_NODES_THREAD_CACHE     /**< Process-wide cache with per-thread magazines of free nodes; suited to
+                                     many threads churning short-lived lists. */
+} ListNodeSource;
+
+/**
+ * @struct ListOptions
+ * @brief Optional tuning knobs for list_create_with_options. Zero fields select defaults,
+ * and fields that do not apply to the chosen ListType are ignored.
+ */
+typedef struct ListOptions {
+    size_t chunk_capacity;  /**< LIST_UNROLLED: data pointers per chunk (default: one cache line). */
+    uint64_t seed;          /**< LIST_SKIP: RNG seed for node heights (default: a fixed seed). */
+    size_t slab_nodes;      /**< LIST_LINKED_SENTINEL: largest node slab; slabs double from one
+                                 node up to this size (default: 256). */
+    size_t arena_chunk;     /**< Any type: when nonzero, bump-allocate all storage from chunks of
+                                 this many bytes. Frees are deferred to list_destroy, which then
+                                 only frees the chunks when free_func is NULL. */
+    ListNodeSource node_source; /**< LIST_LINKED_SENTINEL: node allocator. The thread cache is
+                                 only used with the default allocator and without an arena. */
+} ListOptions;
+
+/**
+ * @struct ListAllocator
+ * @brief Per-list allocator for list_create_with_allocator. alloc and free are
+ * called with ctx as their first argument for the List itself and for all of
+ * its internal storage, so they must stay valid until list_destroy returns.
+ */
+typedef struct ListAllocator {
+    void *(*alloc)(void *ctx, size_t size);  /**< Returns NULL on failure. */
+    void (*free)(void *ctx, void *ptr);      /**< Releases a block returned by alloc. */
+    void *ctx;                               /**< Passed through unchanged. */
+} ListAllocator;
+
+/**
+ * @struct ListRegionPool
+ * @brief Opaque pool of large mmap'd regions that list storage is carved from
+ * (see list_region_pool_create). Not thread-safe: share a pool only between
+ * lists used by the same thread.
+ */
+typedef struct ListRegionPool ListRegionPool;
+
+/**
+ * @struct ListRegionStats
+ * @brief Counters reported by list_region_pool_stats.
+ */
+typedef struct ListRegionStats {
+    size_t regions;         /**< Standard regions currently mapped. */
+    size_t idle_regions;    /**< Of those, empty ones whose pages were dropped. */
+    size_t mapped_bytes;    /**< Address space mapped, including dedicated large blocks. */
+    size_t live_blocks;     /**< Blocks allocated and not yet freed. */
+} ListRegionStats;
+
 /**
  * @typedef FreeFunc
  * @brief Function pointer type for freeing elements. If NULL, no action is taken.
@@ -45,20 +134,196 @@ typedef enum {
 typedef void (*FreeFunc)(void *);
 
 
+/**
+ * @typedef ListVisitFn
+ * @brief Callback for list_foreach. Return false to stop the traversal.
+ */
+typedef bool (*ListVisitFn)(void *data, void *ctx);
+
+/**
+ * @typedef ListMapFn
+ * @brief Callback for list_map_inplace: returns the value to store in place of data.
+ */
+typedef void *(*ListMapFn)(void *data, void *ctx);
+
+/**
+ * @typedef ListReduceFn
+ * @brief Callback for list_reduce: folds data into the accumulator and returns the new one.
+ */
+typedef void *(*ListReduceFn)(void *acc, void *data, void *ctx);
+
+/**
+ * @struct ListAdaptiveStats
+ * @brief Operation counters and layout decisions of a LIST_ADAPTIVE list.
+ */
+typedef struct ListAdaptiveStats {
+    ListType layout;        /**< Layout in use: LIST_LINKED_SENTINEL or LIST_ARRAY. */
+    size_t appends;         /**< Successful list_append calls. */
+    size_t inserts;         /**< Successful list_insert calls. */
+    size_t removes;         /**< Successful list_remove calls. */
+    size_t gets;            /**< In-bounds list_get calls. */
+    size_t migrations;      /**< Total layout switches (to_array + to_linked). */
+    size_t to_array;        /**< Switches from the sentinel layout to the array layout. */
+    size_t to_linked;       /**< Switches from the array layout to the sentinel layout. */
+} ListAdaptiveStats;
+
+/**
+ * @struct ListMemStats
+ * @brief Allocation counters of one list, reported by list_memory_stats. Sizes
+ * are the bytes the list requested, including the List itself; allocator
+ * headers, arena chunks and region pages around them are not counted.
+ */
+typedef struct ListMemStats {
+    size_t bytes;           /**< Bytes currently held. */
+    size_t peak_bytes;      /**< High-water mark of bytes. */
+    size_t live_nodes;      /**< Blocks currently held: nodes, chunks, slabs or slot buffers. */
+    size_t alloc_calls;     /**< Blocks obtained over the list's lifetime. */
+} ListMemStats;
+
+/**
+ * @enum ListLimitPolicy
+ * @brief What list_append / list_insert do when the list's memory limit
+ * (list_set_memory_limit) would be exceeded.
+ */
+typedef enum {
+    LIST_LIMIT_FAIL,        /**< Return false and leave the list unchanged. */
+    LIST_LIMIT_EVICT_HEAD   /**< Remove elements from the front until the new one fits. */
+} ListLimitPolicy;
+
+/**
+ * @struct ListIter
+ * @brief Cursor over a list, for traversals and edits that do not restart
+ * from the front on every step. Fill it in with list_iter_begin or
+ * list_iter_end. The cursor sits on an element or, once index equals
+ * list_size, past the end. Changing the list other than through this cursor
+ * invalidates it.
+ */
+typedef struct ListIter {
+    List *list;             /**< List being traversed. */
+    size_t index;           /**< Position of the cursor. */
+    void *node;             /**< Backend position; private. */
+    size_t offset;          /**< Backend position inside node; private. */
+} ListIter;
+
 /**
  * @brief Create a new list of the specified type.
  * @param type The type of list to create (e.g., LIST_LINKED_SENTINEL).
- * @return Pointer to the newly created list, or NULL on failure.
+ * @return Pointer to the newly created list, or NULL on failure or unknown type.
  */
 List *list_create(ListType type);
 
 /**
- * @brief Destroy the list and free all associated memory.
+ * @brief Create a new list of the specified type with backend tuning options.
+ * @param type The type of list to create.
+ * @param options Tuning options, or NULL for the defaults used by list_create.
+ * @return Pointer to the newly created list, or NULL on failure or unknown type.
+ */
+List *list_create_with_options(ListType type, const ListOptions *options);
+
+/**
+ * @brief Create a new list whose memory comes from a caller-supplied allocator
+ * instead of the global lab_alloc_fn / lab_free_fn hooks.
+ * @param type The type of list to create.
+ * @param allocator Allocator to copy into the list, or NULL for the global hooks.
+ * @return Pointer to the newly created list, or NULL on failure, unknown type,
+ * or an allocator without alloc/free.
+ */
+List *list_create_with_allocator(ListType type, const ListAllocator *allocator);
+
+/**
+ * @brief Create a pool of mmap'd regions for list storage. Plug it into lists
+ * with list_create_with_allocator(type, &allocator) where allocator comes from
+ * list_region_allocator. Allocation bumps through a region; once every block
+ * in a region has been freed its pages are returned with MADV_DONTNEED (RSS
+ * shrinks) and the region is reused.
+ * @param region_size Bytes per region, rounded up to a power of two of at
+ * least 64 KiB; 0 selects 2 MiB.
+ * @param huge_pages Request transparent huge pages (MADV_HUGEPAGE) where available.
+ * @return The pool, or NULL on allocation failure.
+ */
+ListRegionPool *list_region_pool_create(size_t region_size, bool huge_pages);
+
+/**
+ * @brief Unmap every region of the pool. All lists using it must have been destroyed.
+ * @param pool The pool; NULL is ignored.
+ */
+void list_region_pool_destroy(ListRegionPool *pool);
+
+/**
+ * @brief ListAllocator that allocates from pool.
+ * @param pool The pool; must outlive every list created with the allocator.
+ * @return The allocator, to pass to list_create_with_allocator.
+ */
+ListAllocator list_region_allocator(ListRegionPool *pool);
+
+/**
+ * @brief Report the pool's counters.
+ * @param pool The pool.
+ * @param stats Filled in on success.
+ * @return true on success, false if an argument is NULL.
+ */
+bool list_region_pool_stats(const ListRegionPool *pool, ListRegionStats *stats);
+
+/**
+ * @brief Destroy the list and free all associated memory. For arena lists
+ * (ListOptions::arena_chunk) with a NULL free_func this is O(chunks): the
+ * structure is not walked at all.
  * @param list Pointer to the list to destroy.
  * @param free_func Function to free individual elements. If NULL, elements are not freed.
  */
 void list_destroy(List *list, FreeFunc free_func);
 
+/**
+ * @brief Take an O(1) snapshot that shares structure with the list.
+ *
+ * Both handles behave as independent lists afterwards: a mutation copies only
+ * the O(log n) nodes on its path, so neither handle ever sees the other's
+ * changes and no reader has to copy or block. Node reclamation is reference
+ * counted and goes through the list's allocator. Each handle must be used by one thread at
+ * a time, but different handles can live on different threads.
+ *
+ * Elements are shared too, so pass a free_func to list_destroy only for the
+ * last surviving version.
+ *
+ * @param list Pointer to the list (currently only LIST_BTREE supports snapshots,
+ * and not for lists created with ListOptions::arena_chunk).
+ * @return New list handle, or NULL on failure or if the type has no snapshot support.
+ */
+List *list_snapshot(const List *list);
+
+/**
+ * @brief Preallocate room for n elements. Afterwards appends (and inserts)
+ * do not allocate until the list holds n elements. LIST_LINKED_SENTINEL
+ * reserves a contiguous block of nodes; LIST_ARRAY, LIST_RING and LIST_GAP
+ * size their buffer, and LIST_ARRAY no longer shrinks below it.
+ * @param list Pointer to the list.
+ * @param n Number of elements to make room for, counting those already stored.
+ * @return true on success (or if there already is room), false on allocation
+ * failure or if the backend does not support reserving.
+ */
+bool list_reserve(List *list, size_t n);
+
+/**
+ * @brief Number of elements the list can hold before it next allocates.
+ * Backends without list_reserve support report list_size.
+ * @param list Pointer to the list.
+ * @return Capacity in elements, or 0 if list is NULL.
+ */
+size_t list_capacity(const List *list);
+
+/**
+ * @brief Move all nodes of a LIST_LINKED_SENTINEL list into one contiguous
+ * block in logical order, so a front-to-back traversal becomes a linear
+ * memory scan. Spare capacity from list_reserve is dropped, and a list on the
+ * thread cache owns its nodes afterwards. O(n) time, one allocation.
+ * LIST_ADAPTIVE compacts its linked layout and treats its array layout as
+ * already compact.
+ * @param list Pointer to the list.
+ * @return true on success, false on allocation failure (the list is
+ * unchanged) or if the backend does not support compaction.
+ */
+bool list_compact(List *list);
+
 /**
  * @brief Append an element to the end of the list.
  * @param list Pointer to the list.
@@ -85,13 +350,67 @@ bool list_insert(List *list, size_t index, void *data);
 void *list_remove(List *list, size_t index);
 
 /**
- * @brief Get a pointer the element at a specific index.
+ * @brief Get a pointer the element at a specific index. LIST_LINKED_SENTINEL
+ * walks from the head, the tail or the last accessed node, whichever is
+ * closest, so scanning indices in order costs O(1) per call. Because that
+ * position is cached in the list, sentinel (and LIST_ADAPTIVE) lists must not
+ * be read from several threads at once without synchronization.
  * @param list Pointer to the list.
  * @param index Index of the element to retrieve.
  * @return Pointer to the element, or NULL if index is out of bounds.
  */
 void *list_get(const List *list, size_t index);
 
+/**
+ * @brief Get n elements at once: out[i] receives the element at idx[i].
+ * Indices may come in any order and repeat. Linked backends sort them and
+ * collect everything in one pass over the list (LIST_LINKED_SENTINEL also
+ * seeks through its finger and sparse index), so the cost is one traversal
+ * rather than n; array-style backends read the slots directly.
+ * @param list Pointer to the list.
+ * @param idx Indices to read; all must be < list_size(list).
+ * @param n Number of indices.
+ * @param out Receives the n elements.
+ * @return true on success; false if an argument is NULL (with n > 0), an
+ * index is out of bounds or scratch space for sorting could not be
+ * allocated. out is not written then.
+ */
+bool list_get_many(const List *list, const size_t *idx, size_t n, void **out);
+
+/**
+ * @brief Call fn on every element in order, until it returns false. The
+ * backend walks its own nodes or slots (prefetching the next node on linked
+ * backends), so this is O(n) on every ListType. fn must not modify the list.
+ * @param list Pointer to the list.
+ * @param fn Callback, given each element and ctx.
+ * @param ctx Passed through to fn.
+ * @return Number of elements fn was called on (0 if list or fn is NULL).
+ */
+size_t list_foreach(const List *list, ListVisitFn fn, void *ctx);
+
+/**
+ * @brief Replace every element, in order, with fn(element, ctx). O(n); on a
+ * LIST_BTREE list that shares nodes with a snapshot, the shared nodes are
+ * copied first. fn must not modify the list.
+ * @param list Pointer to the list.
+ * @param fn Callback returning the new element.
+ * @param ctx Passed through to fn.
+ * @return true on success, false if an argument is NULL or the copies could
+ * not be allocated (nothing is replaced then).
+ */
+bool list_map_inplace(List *list, ListMapFn fn, void *ctx);
+
+/**
+ * @brief Fold the elements in order: acc = fn(acc, element, ctx), starting
+ * from init. O(n). fn must not modify the list.
+ * @param list Pointer to the list.
+ * @param fn Callback returning the new accumulator.
+ * @param init Initial accumulator.
+ * @param ctx Passed through to fn.
+ * @return The final accumulator; init if the list is empty or an argument is NULL.
+ */
+void *list_reduce(const List *list, ListReduceFn fn, void *init, void *ctx);
+
 /**
  * @brief Get the current size of the list.
  * @param list Pointer to the list.
@@ -106,4 +425,134 @@ size_t list_size(const List *list);
  */
 bool list_is_empty(const List *list);
 
+/**
+ * @brief Position it on the first element of list.
+ * @param list Pointer to the list.
+ * @param it Iterator to initialize.
+ * @return true if it is on an element, false if the list is empty (it is
+ * then past the end) or an argument is NULL.
+ */
+bool list_iter_begin(List *list, ListIter *it);
+
+/**
+ * @brief Position it past the last element, so list_iter_prev walks the list
+ * backwards.
+ * @param list Pointer to the list.
+ * @param it Iterator to initialize.
+ * @return true if the list has elements, false if it is empty or an argument is NULL.
+ */
+bool list_iter_end(List *list, ListIter *it);
+
+/**
+ * @brief Move to the next element. O(1) on LIST_LINKED_SENTINEL and
+ * LIST_UNROLLED; other backends cost one indexed read per list_iter_get.
+ * That read is O(1) or O(log n) on each of them (LIST_ADAPTIVE's linked
+ * layout reads through the sentinel finger), so a full traversal with a
+ * ListIter is at most O(n log n) on every type.
+ * @param it The iterator.
+ * @return true if it is on an element afterwards, false once it is past the end.
+ */
+bool list_iter_next(ListIter *it);
+
+/**
+ * @brief Move to the previous element.
+ * @param it The iterator.
+ * @return true on success, false if it was already on the first element
+ * (it does not move then).
+ */
+bool list_iter_prev(ListIter *it);
+
+/**
+ * @brief Get the element under the cursor.
+ * @param it The iterator.
+ * @return Pointer to the element, or NULL past the end.
+ */
+void *list_iter_get(const ListIter *it);
+
+/**
+ * @brief Insert an element before the cursor (at the end when it is past the
+ * end). The cursor stays on the element it was on. O(1) on
+ * LIST_LINKED_SENTINEL, O(chunk capacity) on LIST_UNROLLED. A memory limit
+ * makes this fail rather than evict.
+ * @param it The iterator.
+ * @param data Pointer to the data to insert.
+ * @return true on success, false on allocation failure or a NULL iterator.
+ */
+bool list_iter_insert(ListIter *it, void *data);
+
+/**
+ * @brief Remove the element under the cursor and move the cursor to the one
+ * that followed it. O(1) on LIST_LINKED_SENTINEL, O(chunk capacity) on
+ * LIST_UNROLLED.
+ * @param it The iterator.
+ * @return Pointer to the removed element, or NULL past the end.
+ */
+void *list_iter_remove(ListIter *it);
+
+/**
+ * @brief Report the operation mix and layout switches of a LIST_ADAPTIVE list.
+ * @param list Pointer to the list.
+ * @param stats Filled in on success.
+ * @return true on success, false if list is not a LIST_ADAPTIVE list or an argument is NULL.
+ */
+bool list_adaptive_stats(const List *list, ListAdaptiveStats *stats);
+
+/**
+ * @brief Keep a sparse index of every k-th node of a LIST_LINKED_SENTINEL
+ * list, so list_get (and indexed insert/remove) walks at most k nodes from a
+ * checkpoint instead of up to n/2. Node addresses stay stable. An insert or
+ * remove at index i invalidates the checkpoints from i on; they are rebuilt
+ * lazily by the next seek that needs them, so edits near the front of a
+ * large list make the following far seek O(n) again. k around sqrt(n) keeps
+ * both the index (n/k pointers) and the walks small.
+ * @param list Pointer to the list.
+ * @param k Checkpoint spacing in elements, or 0 to drop the index.
+ * @return true on success, false if list is NULL or not a LIST_LINKED_SENTINEL list.
+ */
+bool list_enable_index(List *list, size_t k);
+
+/**
+ * @brief Report how much memory the list holds and has held. Available on
+ * every ListType unless the library was built with -DLAB_NO_MEMORY_STATS,
+ * which removes the counters entirely. A list_snapshot handle starts from
+ * its own List only; nodes it shares are charged to the handle that
+ * allocated them.
+ * @param list Pointer to the list.
+ * @param stats Filled in on success.
+ * @return true on success, false if an argument is NULL or the counters are compiled out.
+ */
+bool list_memory_stats(const List *list, ListMemStats *stats);
+
+/**
+ * @brief Cap the bytes the list may hold, as counted by list_memory_stats.
+ * Any allocation that would go over the limit is refused, so operations that
+ * need one fail as they would on allocation failure. list_append and
+ * list_insert then either fail (LIST_LIMIT_FAIL) or evict from the front and
+ * retry (LIST_LIMIT_EVICT_HEAD) until the element fits or the list is empty;
+ * an insert index shifts down with the evicted elements. Operations that do
+ * not allocate are unaffected, and a limit below the current usage does not
+ * shrink the list. Snapshots start without a limit.
+ * @param list Pointer to the list.
+ * @param bytes Limit in bytes, or 0 to remove the limit.
+ * @param policy What to do when an append or insert hits the limit.
+ * @param evict Called on each evicted element if non-NULL.
+ * @return true on success, false if list is NULL or the library was built
+ * with -DLAB_NO_MEMORY_STATS.
+ */
+bool list_set_memory_limit(List *list, size_t bytes, ListLimitPolicy policy, FreeFunc evict);
+
+/**
+ * @brief Select the node source used by lists created with LIST_NODES_DEFAULT
+ * (including every list made by list_create). Affects lists created afterwards.
+ * @param source LIST_NODES_SLAB or LIST_NODES_THREAD_CACHE; LIST_NODES_DEFAULT restores slabs.
+ */
+void list_set_default_node_source(ListNodeSource source);
+
+/**
+ * @brief Return the free nodes held by the thread cache to the allocator: the
+ * shared depot and the calling thread's magazine. Other threads' magazines are
+ * flushed to the depot when those threads exit.
+ */
+void list_node_cache_trim(void);
+
 #endif // LAB_H
\ No newline at end of file
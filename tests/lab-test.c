@@ -1,6 +1,8 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
 #include "harness/unity.h"
 
 //All tests written by AI
@@ -201,6 +203,1815 @@ static void test_null_list_guards(void) {
   TEST_ASSERT_TRUE(list_is_empty(NULL));
 }
 
+// --- Behaviour shared by every ListType ---
+static const ListType all_types[] = {
+  LIST_LINKED_SENTINEL,
+  LIST_ARRAY,
+  LIST_UNROLLED,
+  LIST_TREE,
+  LIST_SKIP,
+  LIST_RING,
+  LIST_BTREE,
+  LIST_GAP,
+  LIST_TIERED,
+  LIST_ADAPTIVE,
+};
+#define ALL_TYPES_COUNT (sizeof(all_types) / sizeof(all_types[0]))
+
+#define AS_PTR(v) ((void *)(uintptr_t)(v))
+
+static unsigned model_rand(unsigned *state) {
+  *state = *state * 1103515245u + 12345u;
+  return (*state >> 16) & 0x7fffu;
+}
+
+// Runs a pseudo-random mix of append/insert/remove/get against a plain array
+// and checks the list agrees with it after every step.
+static void check_against_model(ListType type, size_t steps, size_t max_size) {
+  List *list = list_create(type);
+  TEST_ASSERT_NOT_NULL(list);
+  uintptr_t *model = malloc(max_size * sizeof(uintptr_t));
+  TEST_ASSERT_NOT_NULL(model);
+  size_t n = 0;
+  unsigned seed = 12345u + (unsigned)type;
+  uintptr_t next_val = 1;
+
+  for (size_t step = 0; step < steps; ++step) {
+    unsigned op = model_rand(&seed) % 8;
+    if (n == max_size) op = 4; // force a remove when full
+    if (op <= 1) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(next_val)));
+      model[n++] = next_val++;
+    } else if (op <= 3) {
+      size_t idx = n ? (size_t)model_rand(&seed) % (n + 1) : 0;
+      TEST_ASSERT_TRUE(list_insert(list, idx, AS_PTR(next_val)));
+      for (size_t i = n; i > idx; --i) model[i] = model[i - 1];
+      model[idx] = next_val++;
+      n++;
+    } else if (op <= 5) {
+      if (n == 0) {
+        TEST_ASSERT_NULL(list_remove(list, 0));
+        continue;
+      }
+      size_t idx = (size_t)model_rand(&seed) % n;
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(model[idx]), list_remove(list, idx));
+      for (size_t i = idx; i + 1 < n; ++i) model[i] = model[i + 1];
+      n--;
+    } else if (n > 0) {
+      size_t idx = (size_t)model_rand(&seed) % n;
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(model[idx]), list_get(list, idx));
+    }
+    TEST_ASSERT_EQUAL_UINT32(n, list_size(list));
+  }
+  for (size_t i = 0; i < n; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(model[i]), list_get(list, i));
+  }
+  TEST_ASSERT_NULL(list_get(list, n));
+  free(model);
+  list_destroy(list, NULL);
+}
+
+static void test_all_types_basic(void) {
+  for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+    List *list = list_create(all_types[t]);
+    TEST_ASSERT_NOT_NULL(list);
+    int a = 1, b = 2, c = 3;
+    TEST_ASSERT_TRUE(list_is_empty(list));
+    TEST_ASSERT_FALSE(list_insert(list, 1, &a));
+    TEST_ASSERT_NULL(list_remove(list, 0));
+    TEST_ASSERT_TRUE(list_append(list, &a));
+    TEST_ASSERT_TRUE(list_append(list, &c));
+    TEST_ASSERT_TRUE(list_insert(list, 1, &b));
+    TEST_ASSERT_EQUAL_PTR(&a, list_get(list, 0));
+    TEST_ASSERT_EQUAL_PTR(&b, list_get(list, 1));
+    TEST_ASSERT_EQUAL_PTR(&c, list_get(list, 2));
+    TEST_ASSERT_NULL(list_get(list, 3));
+    TEST_ASSERT_EQUAL_PTR(&b, list_remove(list, 1));
+    TEST_ASSERT_EQUAL_UINT32(2, list_size(list));
+
+    free_count = 0;
+    list_destroy(list, dummy_free);
+    TEST_ASSERT_EQUAL_INT(2, free_count);
+  }
+}
+
+static void test_all_types_against_model(void) {
+  for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+    check_against_model(all_types[t], 20000, 1500);
+  }
+}
+
+static void test_create_unknown_type(void) {
+  TEST_ASSERT_NULL(list_create((ListType)999));
+}
+
+// --- LIST_ARRAY ---
+static void test_array_grow_and_shrink(void) {
+  List *list = list_create(LIST_ARRAY);
+  TEST_ASSERT_NOT_NULL(list);
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i)));
+  }
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i), list_get(list, i));
+  }
+  for (uintptr_t i = 0; i < 990; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i), list_remove(list, 0));
+  }
+  for (uintptr_t i = 0; i < 10; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(990 + i), list_get(list, i));
+  }
+  list_destroy(list, NULL);
+}
+
+static void test_array_alloc_failure(void) {
+  List *list = list_create(LIST_ARRAY);
+  int a = 1, b = 2;
+
+  alloc_fail_after = 1; // first append allocates the buffer
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_append(list, &a));
+  TEST_ASSERT_TRUE(list_is_empty(list));
+
+  alloc_fail_after = -1;
+  for (int i = 0; i < 8; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, &a));
+  }
+
+  alloc_fail_after = 1; // buffer is full, the ninth slot needs a resize
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_insert(list, 0, &b));
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_append(list, &b));
+  TEST_ASSERT_EQUAL_UINT32(8, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(&a, list_get(list, 0));
+
+  alloc_fail_after = -1;
+  list_destroy(list, NULL);
+}
+
+// --- LIST_UNROLLED ---
+static void test_unrolled_small_chunks_against_model(void) {
+  // Tiny chunks force a split or merge on almost every insert/remove
+  size_t caps[] = { 1, 2, 3, 5, 64 };
+  for (size_t c = 0; c < sizeof(caps) / sizeof(caps[0]); ++c) {
+    ListOptions opts = { .chunk_capacity = caps[c] };
+    List *list = list_create_with_options(LIST_UNROLLED, &opts);
+    TEST_ASSERT_NOT_NULL(list);
+    for (uintptr_t i = 0; i < 200; ++i) {
+      TEST_ASSERT_TRUE(list_insert(list, (size_t)(i / 2), AS_PTR(i)));
+    }
+    // Every insert at i/2 lands just before the previous middle: rebuild the expected order
+    uintptr_t expected[200];
+    size_t n = 0;
+    for (uintptr_t i = 0; i < 200; ++i) {
+      size_t idx = (size_t)(i / 2);
+      for (size_t j = n; j > idx; --j) expected[j] = expected[j - 1];
+      expected[idx] = i;
+      n++;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(expected[i]), list_get(list, i));
+    }
+    while (n > 0) {
+      size_t idx = n / 3;
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(expected[idx]), list_remove(list, idx));
+      for (size_t j = idx; j + 1 < n; ++j) expected[j] = expected[j + 1];
+      n--;
+    }
+    TEST_ASSERT_TRUE(list_is_empty(list));
+    list_destroy(list, NULL);
+  }
+}
+
+static void test_unrolled_alloc_failure(void) {
+  ListOptions opts = { .chunk_capacity = 2 };
+  List *list = list_create_with_options(LIST_UNROLLED, &opts);
+  int a = 1, b = 2, c = 3;
+  TEST_ASSERT_TRUE(list_append(list, &a));
+  TEST_ASSERT_TRUE(list_append(list, &b));
+
+  alloc_fail_after = 1; // chunk is full, the split needs a new chunk
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_insert(list, 1, &c));
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_append(list, &c));
+  TEST_ASSERT_EQUAL_UINT32(2, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(&a, list_get(list, 0));
+  TEST_ASSERT_EQUAL_PTR(&b, list_get(list, 1));
+
+  alloc_fail_after = -1;
+  list_destroy(list, NULL);
+}
+
+// --- LIST_TREE ---
+static void test_tree_large_sequential(void) {
+  // Sorted appends and head inserts are the worst case for an unbalanced tree
+  List *list = list_create(LIST_TREE);
+  const uintptr_t n = 1u << 16;
+  for (uintptr_t i = 0; i < n; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(n + i)));
+    TEST_ASSERT_TRUE(list_insert(list, 0, AS_PTR(n - 1 - i)));
+  }
+  for (uintptr_t i = 0; i < 2 * n; i += 997) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i), list_get(list, i));
+  }
+  for (uintptr_t i = 0; i < n; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(n + i), list_remove(list, n));
+  }
+  TEST_ASSERT_EQUAL_UINT32(n, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(n - 1), list_get(list, n - 1));
+  list_destroy(list, NULL);
+}
+
+static void test_tree_alloc_failure(void) {
+  List *list = list_create(LIST_TREE);
+  int a = 1, b = 2;
+  TEST_ASSERT_TRUE(list_append(list, &a));
+  alloc_fail_after = 1;
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_insert(list, 0, &b));
+  TEST_ASSERT_EQUAL_UINT32(1, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(&a, list_get(list, 0));
+  alloc_fail_after = -1;
+  list_destroy(list, NULL);
+}
+
+// --- LIST_SKIP ---
+static void test_skip_seeds_against_model(void) {
+  uint64_t seeds[] = { 1, 42, 0xdeadbeefull };
+  for (size_t s = 0; s < sizeof(seeds) / sizeof(seeds[0]); ++s) {
+    ListOptions opts = { .seed = seeds[s] };
+    List *list = list_create_with_options(LIST_SKIP, &opts);
+    TEST_ASSERT_NOT_NULL(list);
+    for (uintptr_t i = 0; i < 5000; ++i) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(i)));
+    }
+    for (uintptr_t i = 0; i < 5000; i += 7) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(i), list_get(list, i));
+    }
+    for (uintptr_t i = 0; i < 2500; ++i) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(2 * i), list_remove(list, i));
+    }
+    for (uintptr_t i = 0; i < 2500; ++i) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(2 * i + 1), list_get(list, i));
+    }
+    list_destroy(list, NULL);
+  }
+}
+
+static void test_skip_alloc_failure(void) {
+  alloc_fail_after = 2; // header allocation
+  alloc_call_count = 0;
+  TEST_ASSERT_NULL(list_create(LIST_SKIP));
+
+  alloc_fail_after = -1;
+  List *list = list_create(LIST_SKIP);
+  int a = 1, b = 2;
+  TEST_ASSERT_TRUE(list_append(list, &a));
+  alloc_fail_after = 1;
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_insert(list, 0, &b));
+  TEST_ASSERT_EQUAL_UINT32(1, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(&a, list_get(list, 0));
+  alloc_fail_after = -1;
+  list_destroy(list, NULL);
+}
+
+// --- LIST_RING ---
+static void test_ring_queue_is_allocation_free(void) {
+  List *list = list_create(LIST_RING);
+  for (uintptr_t i = 0; i < 100; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i)));
+  }
+  alloc_call_count = 0;
+  // Queue traffic wraps around the buffer many times without growing it
+  for (uintptr_t i = 100; i < 10000; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i)));
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i - 100), list_remove(list, 0));
+  }
+  // ...and so does deque traffic at the front
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_TRUE(list_insert(list, 0, AS_PTR(i)));
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i), list_remove(list, 0));
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(9999), list_remove(list, list_size(list) - 1));
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(9999)));
+  }
+  TEST_ASSERT_EQUAL_INT(0, alloc_call_count);
+  for (uintptr_t i = 0; i < 100; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(9900 + i), list_get(list, i));
+  }
+  list_destroy(list, NULL);
+}
+
+static void test_ring_grow_while_wrapped(void) {
+  List *list = list_create(LIST_RING);
+  for (uintptr_t i = 0; i < 8; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i)));
+  }
+  for (uintptr_t i = 0; i < 5; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i), list_remove(list, 0));
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(8 + i)));
+  }
+  // Full and wrapped: the next push must unwrap into a bigger buffer
+  alloc_fail_after = 1;
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_insert(list, 0, AS_PTR(99)));
+  alloc_fail_after = -1;
+  TEST_ASSERT_TRUE(list_insert(list, 0, AS_PTR(4)));
+  for (uintptr_t i = 0; i < 9; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(4 + i), list_get(list, i));
+  }
+  list_destroy(list, NULL);
+}
+
+// --- LIST_BTREE ---
+static void test_btree_multi_level_against_model(void) {
+  // Large enough for two inner levels with 64-slot leaves and fan-out 32
+  check_against_model(LIST_BTREE, 120000, 40000);
+}
+
+static void test_btree_append_then_drain(void) {
+  List *list = list_create(LIST_BTREE);
+  const uintptr_t n = 100000;
+  for (uintptr_t i = 0; i < n; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i)));
+  }
+  for (uintptr_t i = 0; i < n; i += 101) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i), list_get(list, i));
+  }
+  // Drain from the middle so merges and borrows hit every level
+  for (uintptr_t i = 0; i < n; ++i) {
+    size_t mid = list_size(list) / 2;
+    void *expected = list_get(list, mid);
+    TEST_ASSERT_EQUAL_PTR(expected, list_remove(list, mid));
+  }
+  TEST_ASSERT_TRUE(list_is_empty(list));
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(7)));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(7), list_get(list, 0));
+  list_destroy(list, NULL);
+}
+
+static void test_btree_split_alloc_failure(void) {
+  List *list = list_create(LIST_BTREE);
+  // 64 fills the root leaf, 64 more forces a split to a new root, then fill
+  for (uintptr_t i = 0; i < 64 * 32; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i)));
+  }
+  // Root has 32 full leaves: a middle insert needs a leaf, an inner and a new root
+  for (int fail_at = 1; fail_at <= 3; ++fail_at) {
+    alloc_fail_after = fail_at;
+    alloc_call_count = 0;
+    TEST_ASSERT_FALSE(list_insert(list, 1000, AS_PTR(9999)));
+    TEST_ASSERT_EQUAL_UINT32(64 * 32, list_size(list));
+  }
+  alloc_fail_after = -1;
+  for (uintptr_t i = 0; i < 64 * 32; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i), list_get(list, i));
+  }
+  TEST_ASSERT_TRUE(list_insert(list, 1000, AS_PTR(9999)));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(9999), list_get(list, 1000));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(1000), list_get(list, 1001));
+  list_destroy(list, NULL);
+}
+
+// --- LIST_GAP ---
+static void test_gap_cursor_edits(void) {
+  List *list = list_create(LIST_GAP);
+  for (uintptr_t i = 0; i < 100; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i)));
+  }
+  // Type three characters at 50, delete one behind the cursor, then jump back
+  TEST_ASSERT_TRUE(list_insert(list, 50, AS_PTR(1000)));
+  TEST_ASSERT_TRUE(list_insert(list, 51, AS_PTR(1001)));
+  TEST_ASSERT_TRUE(list_insert(list, 52, AS_PTR(1002)));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(1002), list_remove(list, 52));
+  TEST_ASSERT_TRUE(list_insert(list, 10, AS_PTR(1003)));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(9), list_get(list, 9));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(1003), list_get(list, 10));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(49), list_get(list, 50));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(1000), list_get(list, 51));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(1001), list_get(list, 52));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(50), list_get(list, 53));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(99), list_get(list, 102));
+  TEST_ASSERT_EQUAL_UINT32(103, list_size(list));
+  list_destroy(list, NULL);
+}
+
+static void test_gap_grow_alloc_failure(void) {
+  List *list = list_create(LIST_GAP);
+  for (uintptr_t i = 0; i < 8; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i)));
+  }
+  alloc_fail_after = 1; // gap is closed, the insert must grow
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_insert(list, 3, AS_PTR(99)));
+  alloc_fail_after = -1;
+  TEST_ASSERT_TRUE(list_insert(list, 3, AS_PTR(99)));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(2), list_get(list, 2));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(99), list_get(list, 3));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(3), list_get(list, 4));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(7), list_get(list, 8));
+  list_destroy(list, NULL);
+}
+
+// --- LIST_TIERED ---
+static void test_tiered_grow_and_shrink_tiers(void) {
+  // Crosses several powers of four on the way up and back down
+  List *list = list_create(LIST_TIERED);
+  const uintptr_t n = 20000;
+  for (uintptr_t i = 0; i < n; ++i) {
+    TEST_ASSERT_TRUE(list_insert(list, (size_t)(i / 2), AS_PTR(i + 1)));
+  }
+  for (uintptr_t i = 0; i < n; ++i) {
+    size_t idx = list_size(list) - 1 - (size_t)(i % list_size(list));
+    void *expected = list_get(list, idx);
+    TEST_ASSERT_NOT_NULL(expected);
+    TEST_ASSERT_EQUAL_PTR(expected, list_remove(list, idx));
+  }
+  TEST_ASSERT_TRUE(list_is_empty(list));
+  for (uintptr_t i = 0; i < 100; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  for (uintptr_t i = 0; i < 100; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i + 1), list_get(list, i));
+  }
+  list_destroy(list, NULL);
+}
+
+static void test_tiered_alloc_failure(void) {
+  List *list = list_create(LIST_TIERED);
+  for (uintptr_t i = 0; i < 8; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i)));
+  }
+  alloc_fail_after = 1; // only tier is full: a new tier is needed
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_insert(list, 0, AS_PTR(99)));
+  alloc_fail_after = -1;
+  TEST_ASSERT_EQUAL_UINT32(8, list_size(list));
+  TEST_ASSERT_TRUE(list_insert(list, 0, AS_PTR(99)));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(99), list_get(list, 0));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(7), list_get(list, 8));
+  list_destroy(list, NULL);
+}
+
+// --- list_snapshot (LIST_BTREE) ---
+static void test_snapshot_is_isolated(void) {
+  List *list = list_create(LIST_BTREE);
+  const uintptr_t n = 5000;
+  for (uintptr_t i = 0; i < n; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  List *snap = list_snapshot(list);
+  TEST_ASSERT_NOT_NULL(snap);
+  TEST_ASSERT_EQUAL_UINT32(n, list_size(snap));
+
+  // Writer keeps editing; the snapshot must not change
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_TRUE(list_insert(list, (size_t)(i * 3), AS_PTR(100000 + i)));
+    TEST_ASSERT_NOT_NULL(list_remove(list, (size_t)(n - i)));
+  }
+  for (uintptr_t i = 0; i < n; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i + 1), list_get(snap, i));
+  }
+
+  // The snapshot is writable too, without touching the original
+  void *first = list_get(list, 0);
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(1), list_remove(snap, 0));
+  TEST_ASSERT_EQUAL_PTR(first, list_get(list, 0));
+  TEST_ASSERT_EQUAL_UINT32(n - 1, list_size(snap));
+
+  list_destroy(list, NULL);
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(2), list_get(snap, 0));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(n), list_get(snap, n - 2));
+  list_destroy(snap, NULL);
+}
+
+static void test_snapshot_chain_against_copies(void) {
+  // Every version must keep the contents it had when it was taken
+  enum { VERSIONS = 6, N = 3000 };
+  List *versions[VERSIONS];
+  uintptr_t *expected[VERSIONS];
+  List *list = list_create(LIST_BTREE);
+  uintptr_t model[N + VERSIONS * 400];
+  size_t n = 0;
+  unsigned seed = 7;
+  for (size_t v = 0; v < VERSIONS; ++v) {
+    for (size_t i = 0; i < 400; ++i) {
+      size_t idx = n ? (size_t)model_rand(&seed) % (n + 1) : 0;
+      uintptr_t val = (uintptr_t)(v * 1000 + i + 1);
+      TEST_ASSERT_TRUE(list_insert(list, idx, AS_PTR(val)));
+      for (size_t j = n; j > idx; --j) model[j] = model[j - 1];
+      model[idx] = val;
+      n++;
+      if (i % 3 == 0) {
+        size_t r = (size_t)model_rand(&seed) % n;
+        TEST_ASSERT_EQUAL_PTR(AS_PTR(model[r]), list_remove(list, r));
+        for (size_t j = r; j + 1 < n; ++j) model[j] = model[j + 1];
+        n--;
+      }
+    }
+    versions[v] = list_snapshot(list);
+    TEST_ASSERT_NOT_NULL(versions[v]);
+    expected[v] = malloc((n + 1) * sizeof(uintptr_t));
+    for (size_t j = 0; j < n; ++j) expected[v][j] = model[j];
+    expected[v][n] = 0;
+  }
+  list_destroy(list, NULL);
+  for (size_t v = 0; v < VERSIONS; ++v) {
+    size_t len = 0;
+    while (expected[v][len]) len++;
+    TEST_ASSERT_EQUAL_UINT32(len, list_size(versions[v]));
+    for (size_t j = 0; j < len; ++j) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(expected[v][j]), list_get(versions[v], j));
+    }
+  }
+  // Release out of order; ASan's leak check covers the refcounting
+  for (size_t v = 1; v < VERSIONS; v += 2) list_destroy(versions[v], NULL);
+  for (size_t v = 0; v < VERSIONS; v += 2) list_destroy(versions[v], NULL);
+  for (size_t v = 0; v < VERSIONS; ++v) free(expected[v]);
+}
+
+static void test_snapshot_copy_on_write_alloc_failure(void) {
+  List *list = list_create(LIST_BTREE);
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  List *snap = list_snapshot(list);
+  alloc_fail_after = 1; // copying the shared root fails
+  alloc_call_count = 0;
+  TEST_ASSERT_NULL(list_remove(list, 500));
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_insert(list, 500, AS_PTR(9999)));
+  alloc_fail_after = 2; // root copied, shared leaf copy fails
+  alloc_call_count = 0;
+  TEST_ASSERT_NULL(list_remove(list, 500));
+  alloc_fail_after = -1;
+  TEST_ASSERT_EQUAL_UINT32(1000, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(501), list_remove(list, 500));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(501), list_get(snap, 500));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(502), list_get(list, 500));
+  list_destroy(snap, NULL);
+  list_destroy(list, NULL);
+}
+
+static void test_snapshot_unsupported_types(void) {
+  TEST_ASSERT_NULL(list_snapshot(NULL));
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  TEST_ASSERT_NULL(list_snapshot(list));
+  list_destroy(list, NULL);
+}
+
+// --- LIST_LINKED_SENTINEL node slabs ---
+static void test_sentinel_slabs_recycle_nodes(void) {
+  ListOptions opts = { .slab_nodes = 8 };
+  List *list = list_create_with_options(LIST_LINKED_SENTINEL, &opts);
+  alloc_call_count = 0;
+  for (uintptr_t i = 0; i < 100; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  // Slabs of 1, 2 and 4 nodes, then twelve full slabs of 8
+  TEST_ASSERT_EQUAL_INT(15, alloc_call_count);
+
+  alloc_call_count = 0;
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    size_t idx = (size_t)(i * 7) % 100;
+    void *data = list_remove(list, idx);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_TRUE(list_insert(list, (idx + 13) % 100, data));
+  }
+  TEST_ASSERT_EQUAL_INT(0, alloc_call_count);
+  TEST_ASSERT_EQUAL_UINT32(100, list_size(list));
+
+  free_count = 0;
+  list_destroy(list, dummy_free);
+  TEST_ASSERT_EQUAL_INT(100, free_count);
+}
+
+// Index access near the previous one (and edits next to it) must keep the
+// cached finger in step with the list. A 100k-element scan by index is only
+// fast because each list_get starts from the previous node.
+static void test_sentinel_finger_seeks(void) {
+  const size_t n = 100000;
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  for (uintptr_t i = 0; i < n; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  for (size_t i = 0; i < n; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i + 1), list_get(list, i));
+  }
+  for (size_t i = n; i-- > 0;) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i + 1), list_get(list, i));
+  }
+  list_destroy(list, NULL);
+
+  list = list_create(LIST_LINKED_SENTINEL);
+  uintptr_t model[600];
+  size_t size = 0;
+  unsigned seed = 99u;
+  size_t pos = 0;
+  for (size_t step = 0; step < 20000; ++step) {
+    unsigned op = model_rand(&seed) % 8;
+    pos = size ? (pos + (size_t)model_rand(&seed) % 5 + size - 2) % size : 0;
+    if (op == 0 && size < 600) {
+      TEST_ASSERT_TRUE(list_insert(list, pos, AS_PTR(step + 1)));
+      for (size_t i = size; i > pos; --i) model[i] = model[i - 1];
+      model[pos] = step + 1;
+      size++;
+    } else if (op == 1 && size > 0) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(model[pos]), list_remove(list, pos));
+      for (size_t i = pos; i + 1 < size; ++i) model[i] = model[i + 1];
+      size--;
+    } else if (op == 2 && size < 600) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(step + 1)));
+      model[size++] = step + 1;
+    } else if (op == 3 && size > 0) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(model[0]), list_remove(list, 0));
+      for (size_t i = 0; i + 1 < size; ++i) model[i] = model[i + 1];
+      size--;
+    } else if (size > 0) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(model[pos]), list_get(list, pos));
+    }
+  }
+  for (size_t i = 0; i < size; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(model[i]), list_get(list, i));
+  }
+  TEST_ASSERT_TRUE(list_compact(list)); // moves every node, including the finger's
+  for (size_t i = size; i-- > 0;) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(model[i]), list_get(list, i));
+  }
+  list_destroy(list, NULL);
+}
+
+// Random edits, gets and cursor edits with a small stride so checkpoints
+// are invalidated and rebuilt all the time.
+static void test_sentinel_index_against_model(void) {
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  TEST_ASSERT_TRUE(list_enable_index(list, 8));
+  uintptr_t model[2000];
+  size_t n = 0;
+  unsigned seed = 4242u;
+  for (size_t step = 0; step < 30000; ++step) {
+    unsigned op = model_rand(&seed) % 10;
+    size_t idx = n ? (size_t)model_rand(&seed) % n : 0;
+    if (op <= 1 && n < 2000) {
+      TEST_ASSERT_TRUE(list_insert(list, idx, AS_PTR(step + 1)));
+      for (size_t i = n; i > idx; --i) model[i] = model[i - 1];
+      model[idx] = step + 1;
+      n++;
+    } else if (op == 2 && n < 2000) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(step + 1)));
+      model[n++] = step + 1;
+    } else if (op == 3 && n > 0) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(model[idx]), list_remove(list, idx));
+      for (size_t i = idx; i + 1 < n; ++i) model[i] = model[i + 1];
+      n--;
+    } else if (op == 4 && n > 0) {
+      ListIter it;
+      TEST_ASSERT_TRUE(list_iter_begin(list, &it));
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(model[0]), list_iter_remove(&it));
+      for (size_t i = 0; i + 1 < n; ++i) model[i] = model[i + 1];
+      n--;
+    } else if (op == 5 && step % 1000 == 5) {
+      TEST_ASSERT_TRUE(list_enable_index(list, 1 + (size_t)model_rand(&seed) % 40));
+    } else if (n > 0) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(model[idx]), list_get(list, idx));
+    }
+  }
+  for (size_t i = 0; i < n; ++i) { // scattered order, so seeks go through the index
+    size_t at = (i * 7919) % n;
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(model[at]), list_get(list, at));
+  }
+  list_destroy(list, NULL);
+}
+
+static void test_sentinel_index_memory_and_guards(void) {
+  TEST_ASSERT_FALSE(list_enable_index(NULL, 16));
+  List *other = list_create(LIST_ARRAY);
+  TEST_ASSERT_FALSE(list_enable_index(other, 16));
+  list_destroy(other, NULL);
+
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  for (uintptr_t i = 0; i < 10000; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+#ifndef LAB_NO_MEMORY_STATS
+  ListMemStats before, after;
+  TEST_ASSERT_TRUE(list_memory_stats(list, &before));
+#endif
+  TEST_ASSERT_TRUE(list_enable_index(list, 100));
+
+  alloc_fail_after = 1; // the checkpoint array: the seek falls back to walking
+  alloc_call_count = 0;
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(2501), list_get(list, 2500));
+  alloc_fail_after = -1;
+#ifndef LAB_NO_MEMORY_STATS
+  TEST_ASSERT_TRUE(list_memory_stats(list, &after));
+  TEST_ASSERT_EQUAL_UINT64(before.bytes, after.bytes);
+#endif
+
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(7501), list_get(list, 7500));
+#ifndef LAB_NO_MEMORY_STATS
+  TEST_ASSERT_TRUE(list_memory_stats(list, &after));
+  TEST_ASSERT_TRUE(after.bytes > before.bytes); // checkpoints are charged to the list
+#endif
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(5001), list_remove(list, 5000));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(7502), list_get(list, 7500));
+  TEST_ASSERT_TRUE(list_enable_index(list, 0)); // frees the checkpoints
+#ifndef LAB_NO_MEMORY_STATS
+  TEST_ASSERT_TRUE(list_memory_stats(list, &after));
+  TEST_ASSERT_EQUAL_UINT64(before.bytes, after.bytes);
+#endif
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(3001), list_get(list, 3000));
+  list_destroy(list, NULL);
+}
+
+static void test_sentinel_slab_alloc_failure(void) {
+  ListOptions opts = { .slab_nodes = 4 };
+  List *list = list_create_with_options(LIST_LINKED_SENTINEL, &opts);
+  for (uintptr_t i = 0; i < 7; ++i) { // exactly fills the 1, 2 and 4 node slabs
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  alloc_fail_after = 1;
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_insert(list, 3, AS_PTR(100)));
+  TEST_ASSERT_EQUAL_UINT32(7, list_size(list));
+
+  // A removed node is reused, so the same insert no longer needs a slab
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(7), list_remove(list, 6));
+  alloc_call_count = 0;
+  TEST_ASSERT_TRUE(list_insert(list, 3, AS_PTR(100)));
+  alloc_fail_after = -1;
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(100), list_get(list, 3));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(4), list_get(list, 4));
+  list_destroy(list, NULL);
+}
+
+// --- ListAllocator ---
+typedef struct CountingCtx {
+  size_t allocs;
+  size_t live;
+  size_t fail_at; // 0: never fail
+} CountingCtx;
+
+static void *counting_alloc(void *ctx, size_t size) {
+  CountingCtx *c = ctx;
+  if (++c->allocs == c->fail_at) return NULL;
+  c->live++;
+  return malloc(size);
+}
+
+static void counting_free(void *ctx, void *ptr) {
+  CountingCtx *c = ctx;
+  c->live--;
+  free(ptr);
+}
+
+static void test_allocator_is_per_list(void) {
+  for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+    CountingCtx ctx = { 0 };
+    ListAllocator allocator = { counting_alloc, counting_free, &ctx };
+    alloc_call_count = 0;
+    List *list = list_create_with_allocator(all_types[t], &allocator);
+    TEST_ASSERT_NOT_NULL(list);
+    for (uintptr_t i = 0; i < 3000; ++i) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+    }
+    for (uintptr_t i = 0; i < 500; ++i) {
+      TEST_ASSERT_TRUE(list_insert(list, 1500, AS_PTR(i + 1)));
+      TEST_ASSERT_NOT_NULL(list_remove(list, 10));
+    }
+    while (list_size(list) > 100) {
+      TEST_ASSERT_NOT_NULL(list_remove(list, list_size(list) - 1));
+    }
+    List *snap = list_snapshot(list);
+    list_destroy(list, NULL);
+    list_destroy(snap, NULL);
+    TEST_ASSERT_EQUAL_INT(0, alloc_call_count); // the global hooks were never used
+    TEST_ASSERT_TRUE(ctx.allocs > 0);
+    TEST_ASSERT_EQUAL_UINT32(0, ctx.live);
+  }
+}
+
+static void test_allocator_failure_and_guards(void) {
+  CountingCtx ctx = { .fail_at = 1 }; // the List itself
+  ListAllocator allocator = { counting_alloc, counting_free, &ctx };
+  TEST_ASSERT_NULL(list_create_with_allocator(LIST_LINKED_SENTINEL, &allocator));
+  ctx = (CountingCtx){ .fail_at = 2 }; // the sentinel node
+  TEST_ASSERT_NULL(list_create_with_allocator(LIST_LINKED_SENTINEL, &allocator));
+  TEST_ASSERT_EQUAL_UINT32(0, ctx.live);
+
+  ctx = (CountingCtx){ .fail_at = 3 }; // the first node slab
+  List *list = list_create_with_allocator(LIST_LINKED_SENTINEL, &allocator);
+  TEST_ASSERT_FALSE(list_append(list, AS_PTR(1)));
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(1)));
+  list_destroy(list, NULL);
+  TEST_ASSERT_EQUAL_UINT32(0, ctx.live);
+
+  ListAllocator incomplete = { counting_alloc, NULL, &ctx };
+  TEST_ASSERT_NULL(list_create_with_allocator(LIST_ARRAY, &incomplete));
+  TEST_ASSERT_NULL(list_create_with_allocator((ListType)999, &allocator));
+
+  alloc_call_count = 0; // NULL falls back to the global hooks
+  list = list_create_with_allocator(LIST_ARRAY, NULL);
+  TEST_ASSERT_NOT_NULL(list);
+  TEST_ASSERT_EQUAL_INT(1, alloc_call_count);
+  list_destroy(list, NULL);
+}
+
+// --- Arena mode ---
+static void test_arena_lists_allocate_in_chunks(void) {
+  ListOptions opts = { .arena_chunk = 64 * 1024 };
+  for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+    alloc_call_count = 0;
+    List *list = list_create_with_options(all_types[t], &opts);
+    TEST_ASSERT_NOT_NULL(list);
+    for (uintptr_t i = 0; i < 5000; ++i) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+    }
+    for (uintptr_t i = 0; i < 200; ++i) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(i + 1), list_remove(list, 0));
+      TEST_ASSERT_TRUE(list_insert(list, 2500, AS_PTR(i + 1)));
+    }
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(201), list_get(list, 0));
+    TEST_ASSERT_TRUE(alloc_call_count < 40); // chunks, not nodes
+    alloc_call_count = 0;
+    list_destroy(list, NULL); // chunks only; ASan builds check nothing leaks
+    TEST_ASSERT_EQUAL_INT(0, alloc_call_count);
+  }
+}
+
+static void test_arena_free_func_and_failures(void) {
+  ListOptions opts = { .arena_chunk = 1 }; // rounded up to the minimum chunk
+  List *list = list_create_with_options(LIST_TREE, &opts);
+  alloc_fail_after = 1; // the first chunk
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_append(list, AS_PTR(1)));
+  alloc_fail_after = -1;
+  for (uintptr_t i = 0; i < 300; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  free_count = 0;
+  list_destroy(list, dummy_free);
+  TEST_ASSERT_EQUAL_INT(300, free_count);
+
+  alloc_fail_after = 2; // List succeeds, the sentinel's chunk fails
+  alloc_call_count = 0;
+  TEST_ASSERT_NULL(list_create_with_options(LIST_LINKED_SENTINEL, &opts));
+  alloc_fail_after = -1;
+
+  list = list_create_with_options(LIST_BTREE, &opts);
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(1)));
+  TEST_ASSERT_NULL(list_snapshot(list)); // shared nodes would outlive the arena
+  list_destroy(list, NULL);
+}
+
+// --- Thread-local node cache ---
+static void test_node_cache_recycles_nodes(void) {
+  ListOptions opts = { .node_source = LIST_NODES_THREAD_CACHE };
+  list_node_cache_trim();
+  List *list = list_create_with_options(LIST_LINKED_SENTINEL, &opts);
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  free_count = 0;
+  list_destroy(list, dummy_free);
+  TEST_ASSERT_EQUAL_INT(1000, free_count);
+
+  alloc_call_count = 0;
+  list = list_create_with_options(LIST_LINKED_SENTINEL, &opts);
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_TRUE(list_insert(list, i / 2, AS_PTR(i + 1)));
+  }
+  TEST_ASSERT_EQUAL_INT(2, alloc_call_count); // List and sentinel; every node was cached
+  list_destroy(list, NULL);
+
+  // Lists on a custom allocator keep their own slabs
+  CountingCtx ctx = { 0 };
+  ListAllocator allocator = { counting_alloc, counting_free, &ctx };
+  list_set_default_node_source(LIST_NODES_THREAD_CACHE);
+  list = list_create_with_allocator(LIST_LINKED_SENTINEL, &allocator);
+  list_set_default_node_source(LIST_NODES_DEFAULT);
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(1)));
+  TEST_ASSERT_EQUAL_UINT32(3, ctx.allocs);
+  list_destroy(list, NULL);
+  TEST_ASSERT_EQUAL_UINT32(0, ctx.live);
+  list_node_cache_trim();
+}
+
+// A miss with an empty depot allocates a whole magazine (64 nodes) at once
+static void test_node_cache_fills_whole_magazines(void) {
+  ListOptions opts = { .node_source = LIST_NODES_THREAD_CACHE };
+  list_node_cache_trim();
+  alloc_call_count = 0;
+  List *list = list_create_with_options(LIST_LINKED_SENTINEL, &opts);
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(1)));
+  TEST_ASSERT_EQUAL_INT(2 + 64, alloc_call_count);
+  for (uintptr_t i = 1; i < 64; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  TEST_ASSERT_EQUAL_INT(2 + 64, alloc_call_count);
+  list_destroy(list, NULL);
+  list_node_cache_trim();
+
+  // A fill cut short still serves the nodes it got; none at all fails
+  list = list_create_with_options(LIST_LINKED_SENTINEL, &opts);
+  alloc_fail_after = 4; // fourth node of the fill
+  alloc_call_count = 0;
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(1)));
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(2)));
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(3)));
+  alloc_fail_after = 1;
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_append(list, AS_PTR(4)));
+  alloc_fail_after = -1;
+  TEST_ASSERT_EQUAL_UINT32(3, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(3), list_get(list, 2));
+  list_destroy(list, NULL);
+  list_node_cache_trim();
+}
+
+static void *node_cache_worker(void *arg) {
+  List *handed = arg; // built on the main thread, torn down here
+  list_destroy(handed, NULL);
+  ListOptions opts = { .node_source = LIST_NODES_THREAD_CACHE };
+  for (int round = 0; round < 20; ++round) {
+    List *list = list_create_with_options(LIST_LINKED_SENTINEL, &opts);
+    for (uintptr_t i = 0; i < 500; ++i) {
+      if (!list_append(list, AS_PTR(i + 1))) return AS_PTR(1);
+    }
+    for (uintptr_t i = 0; i < 250; ++i) {
+      if (list_remove(list, 0) != AS_PTR(i + 1)) return AS_PTR(1);
+    }
+    if (list_get(list, 0) != AS_PTR(251)) return AS_PTR(1);
+    list_destroy(list, NULL);
+  }
+  return NULL;
+}
+
+static void test_node_cache_across_threads(void) {
+  enum { THREADS = 8 };
+  pthread_t threads[THREADS];
+  lab_alloc_fn = NULL; // the counting hook is not thread-safe
+  lab_free_fn = NULL;
+  list_set_default_node_source(LIST_NODES_THREAD_CACHE);
+  for (int t = 0; t < THREADS; ++t) {
+    List *handed = list_create(LIST_LINKED_SENTINEL);
+    for (uintptr_t i = 0; i < 300; ++i) {
+      TEST_ASSERT_TRUE(list_append(handed, AS_PTR(i + 1)));
+    }
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[t], NULL, node_cache_worker, handed));
+  }
+  list_set_default_node_source(LIST_NODES_DEFAULT);
+  for (int t = 0; t < THREADS; ++t) {
+    void *result;
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(threads[t], &result));
+    TEST_ASSERT_NULL(result);
+  }
+  list_node_cache_trim(); // exited threads flushed into the depot; ASan checks it is empty now
+}
+
+// --- list_reserve / list_capacity ---
+static void test_reserve_makes_appends_allocation_free(void) {
+  static const ListType reservable[] = { LIST_LINKED_SENTINEL, LIST_ARRAY, LIST_RING, LIST_GAP };
+  for (size_t t = 0; t < sizeof(reservable) / sizeof(reservable[0]); ++t) {
+    List *list = list_create(reservable[t]);
+    for (uintptr_t i = 0; i < 3; ++i) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+    }
+    TEST_ASSERT_TRUE(list_reserve(list, 1000));
+    TEST_ASSERT_TRUE(list_capacity(list) >= 1000);
+    TEST_ASSERT_TRUE(list_reserve(list, 10)); // already has room
+
+    alloc_fail_after = 1; // any allocation from here on fails
+    alloc_call_count = 0;
+    for (uintptr_t i = 3; i < 1000; ++i) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+    }
+    while (list_size(list) > 10) {
+      TEST_ASSERT_NOT_NULL(list_remove(list, list_size(list) - 1));
+    }
+    for (uintptr_t i = 10; i < 1000; ++i) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+    }
+    TEST_ASSERT_EQUAL_INT(0, alloc_call_count);
+    alloc_fail_after = -1;
+    for (uintptr_t i = 0; i < 1000; ++i) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(i + 1), list_get(list, i));
+    }
+    list_destroy(list, NULL);
+  }
+}
+
+static void test_reserve_sentinel_pool_and_guards(void) {
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  alloc_call_count = 0;
+  TEST_ASSERT_TRUE(list_reserve(list, 500));
+  TEST_ASSERT_EQUAL_INT(1, alloc_call_count); // one contiguous block
+  TEST_ASSERT_EQUAL_UINT32(500, list_capacity(list));
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(1)));
+  TEST_ASSERT_EQUAL_UINT32(500, list_capacity(list));
+  alloc_fail_after = 1;
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_reserve(list, 600));
+  alloc_fail_after = -1;
+  TEST_ASSERT_EQUAL_UINT32(500, list_capacity(list));
+  list_destroy(list, NULL);
+
+  ListOptions opts = { .node_source = LIST_NODES_THREAD_CACHE };
+  list = list_create_with_options(LIST_LINKED_SENTINEL, &opts);
+  TEST_ASSERT_TRUE(list_reserve(list, 300));
+  TEST_ASSERT_EQUAL_UINT32(300, list_capacity(list));
+  for (uintptr_t i = 0; i < 200; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  list_destroy(list, NULL);
+  list_node_cache_trim();
+
+  list = list_create(LIST_TREE);
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(1)));
+  TEST_ASSERT_FALSE(list_reserve(list, 100));
+  TEST_ASSERT_EQUAL_UINT32(1, list_capacity(list));
+  list_destroy(list, NULL);
+  TEST_ASSERT_FALSE(list_reserve(NULL, 1));
+  TEST_ASSERT_EQUAL_UINT32(0, list_capacity(NULL));
+}
+
+// --- list_compact ---
+static void test_compact_keeps_order(void) {
+  ListOptions sources[] = { { .slab_nodes = 1 }, { .node_source = LIST_NODES_THREAD_CACHE } };
+  for (size_t c = 0; c < 2; ++c) {
+    List *list = list_create_with_options(LIST_LINKED_SENTINEL, &sources[c]);
+    uintptr_t model[400];
+    size_t n = 0;
+    unsigned seed = 99;
+    for (uintptr_t v = 1; v <= 400; ++v) {
+      size_t idx = (size_t)model_rand(&seed) % (n + 1);
+      TEST_ASSERT_TRUE(list_insert(list, idx, AS_PTR(v)));
+      for (size_t i = n; i > idx; --i) model[i] = model[i - 1];
+      model[idx] = v;
+      n++;
+    }
+    TEST_ASSERT_TRUE(list_reserve(list, 1000));
+
+    alloc_call_count = 0;
+    TEST_ASSERT_TRUE(list_compact(list));
+    TEST_ASSERT_EQUAL_INT(1, alloc_call_count);
+    TEST_ASSERT_EQUAL_UINT32(400, list_capacity(list)); // spare nodes were dropped
+    for (size_t i = 0; i < n; ++i) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(model[i]), list_get(list, i));
+    }
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(model[399]), list_remove(list, 399));
+    TEST_ASSERT_TRUE(list_insert(list, 0, AS_PTR(1000)));
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(model[0]), list_get(list, 1));
+    list_destroy(list, NULL);
+  }
+  list_node_cache_trim();
+}
+
+static void test_compact_failure_and_unsupported(void) {
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  TEST_ASSERT_TRUE(list_compact(list)); // empty
+  for (uintptr_t i = 0; i < 50; ++i) {
+    TEST_ASSERT_TRUE(list_insert(list, 0, AS_PTR(i + 1)));
+  }
+  alloc_fail_after = 1;
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_compact(list));
+  alloc_fail_after = -1;
+  for (uintptr_t i = 0; i < 50; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(50 - i), list_get(list, i));
+  }
+  free_count = 0;
+  list_destroy(list, dummy_free);
+  TEST_ASSERT_EQUAL_INT(50, free_count);
+
+  list = list_create(LIST_ADAPTIVE); // array layout: nothing to do
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(1)));
+  TEST_ASSERT_TRUE(list_compact(list));
+  list_destroy(list, NULL);
+  list = list_create(LIST_TREE);
+  TEST_ASSERT_FALSE(list_compact(list));
+  list_destroy(list, NULL);
+  TEST_ASSERT_FALSE(list_compact(NULL));
+}
+
+// --- mmap region pools ---
+static void test_region_pool_backs_every_type(void) {
+  ListRegionPool *pool = list_region_pool_create(64 * 1024, true);
+  TEST_ASSERT_NOT_NULL(pool);
+  ListAllocator allocator = list_region_allocator(pool);
+  ListRegionStats stats;
+  size_t regions_after_first = 0;
+  for (int pass = 0; pass < 2; ++pass) {
+    for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+      List *list = list_create_with_allocator(all_types[t], &allocator);
+      TEST_ASSERT_NOT_NULL(list);
+      for (uintptr_t i = 0; i < 20000; ++i) { // array-like buffers outgrow a region
+        TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+      }
+      for (uintptr_t i = 0; i < 100; ++i) {
+        TEST_ASSERT_EQUAL_PTR(AS_PTR(i + 1), list_remove(list, 0));
+      }
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(20000), list_get(list, 19899));
+      list_destroy(list, NULL);
+      TEST_ASSERT_TRUE(list_region_pool_stats(pool, &stats));
+      TEST_ASSERT_EQUAL_UINT32(0, stats.live_blocks);
+      TEST_ASSERT_EQUAL_UINT32(stats.regions * 64 * 1024, stats.mapped_bytes); // large blocks unmapped
+      TEST_ASSERT_TRUE(stats.idle_regions + 1 >= stats.regions);
+    }
+    if (pass == 0) {
+      regions_after_first = stats.regions;
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(regions_after_first, stats.regions); // empty regions were reused
+  list_region_pool_destroy(pool);
+}
+
+static void test_region_pool_guards(void) {
+  alloc_fail_after = 1;
+  alloc_call_count = 0;
+  TEST_ASSERT_NULL(list_region_pool_create(0, false));
+  alloc_fail_after = -1;
+  ListRegionStats stats;
+  TEST_ASSERT_FALSE(list_region_pool_stats(NULL, &stats));
+  list_region_pool_destroy(NULL);
+
+  ListRegionPool *pool = list_region_pool_create(1, false); // rounded up to 64 KiB
+  ListAllocator allocator = list_region_allocator(pool);
+  List *list = list_create_with_allocator(LIST_LINKED_SENTINEL, &allocator);
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(1)));
+  TEST_ASSERT_TRUE(list_region_pool_stats(pool, &stats));
+  TEST_ASSERT_EQUAL_UINT32(1, stats.regions);
+  TEST_ASSERT_EQUAL_UINT32(64 * 1024, stats.mapped_bytes);
+  TEST_ASSERT_EQUAL_UINT32(3, stats.live_blocks); // List, sentinel, one slab
+  list_destroy(list, NULL);
+  list_region_pool_destroy(pool);
+}
+
+// --- Memory accounting ---
+#ifndef LAB_NO_MEMORY_STATS
+// Allocator that keeps the size of each block in front of it, as a reference
+// for the counters list_memory_stats reports.
+typedef struct SizedCtx {
+  size_t bytes;
+  size_t peak;
+  size_t live;
+  size_t allocs;
+} SizedCtx;
+
+static void *sized_alloc(void *ctx, size_t size) {
+  SizedCtx *c = ctx;
+  size_t *block = malloc(sizeof(max_align_t) + size);
+  if (!block) return NULL;
+  *block = size;
+  c->bytes += size;
+  c->peak = c->bytes > c->peak ? c->bytes : c->peak;
+  c->live++;
+  c->allocs++;
+  return (char *)block + sizeof(max_align_t);
+}
+
+static void sized_free(void *ctx, void *ptr) {
+  SizedCtx *c = ctx;
+  size_t *block = (size_t *)(void *)((char *)ptr - sizeof(max_align_t));
+  c->bytes -= *block;
+  c->live--;
+  free(block);
+}
+
+static void assert_stats_match(const List *list, const SizedCtx *ctx) {
+  ListMemStats stats;
+  TEST_ASSERT_TRUE(list_memory_stats(list, &stats));
+  TEST_ASSERT_EQUAL_UINT64(ctx->bytes, stats.bytes);
+  TEST_ASSERT_EQUAL_UINT64(ctx->peak, stats.peak_bytes);
+  TEST_ASSERT_EQUAL_UINT64(ctx->live, stats.live_nodes);
+  TEST_ASSERT_EQUAL_UINT64(ctx->allocs, stats.alloc_calls);
+}
+
+static void test_memory_stats_track_the_allocator(void) {
+  for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+    SizedCtx ctx = { 0 };
+    ListAllocator allocator = { sized_alloc, sized_free, &ctx };
+    List *list = list_create_with_allocator(all_types[t], &allocator);
+    TEST_ASSERT_NOT_NULL(list);
+    assert_stats_match(list, &ctx);
+    for (uintptr_t i = 0; i < 3000; ++i) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+    }
+    assert_stats_match(list, &ctx);
+    for (uintptr_t i = 0; i < 500; ++i) {
+      TEST_ASSERT_TRUE(list_insert(list, 1500, AS_PTR(i + 1)));
+      TEST_ASSERT_NOT_NULL(list_remove(list, 10));
+    }
+    for (size_t i = 0; i < 200; ++i) {
+      (void)list_get(list, (i * 7919) % list_size(list)); // lets LIST_ADAPTIVE migrate
+    }
+    while (list_size(list) > 10) {
+      TEST_ASSERT_NOT_NULL(list_remove(list, 0));
+    }
+    (void)list_compact(list);
+    assert_stats_match(list, &ctx);
+    list_destroy(list, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, ctx.live);
+  }
+}
+
+static void test_memory_stats_thread_cache_and_guards(void) {
+  ListMemStats stats;
+  TEST_ASSERT_FALSE(list_memory_stats(NULL, &stats));
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  TEST_ASSERT_FALSE(list_memory_stats(list, NULL));
+  TEST_ASSERT_TRUE(list_memory_stats(list, &stats));
+  size_t empty = stats.bytes;
+  TEST_ASSERT_EQUAL_UINT32(2, stats.live_nodes); // List and sentinel
+  list_destroy(list, NULL);
+
+  ListOptions options = { .node_source = LIST_NODES_THREAD_CACHE };
+  list = list_create_with_options(LIST_LINKED_SENTINEL, &options);
+  for (uintptr_t i = 0; i < 100; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  TEST_ASSERT_TRUE(list_memory_stats(list, &stats));
+  TEST_ASSERT_EQUAL_UINT32(102, stats.live_nodes); // cached nodes count one by one
+  size_t node = (stats.bytes - empty) / 100;
+  TEST_ASSERT_EQUAL_UINT64(empty + 100 * node, stats.bytes);
+  for (int i = 0; i < 50; ++i) {
+    TEST_ASSERT_NOT_NULL(list_remove(list, 0));
+  }
+  TEST_ASSERT_TRUE(list_memory_stats(list, &stats));
+  TEST_ASSERT_EQUAL_UINT64(empty + 50 * node, stats.bytes);
+  TEST_ASSERT_EQUAL_UINT64(empty + 100 * node, stats.peak_bytes);
+  TEST_ASSERT_EQUAL_UINT32(102, stats.alloc_calls);
+  list_destroy(list, NULL);
+  list_node_cache_trim();
+
+  // A snapshot starts with just its own header and never wraps below zero
+  list = list_create(LIST_BTREE);
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  List *snap = list_snapshot(list);
+  TEST_ASSERT_TRUE(list_memory_stats(snap, &stats));
+  TEST_ASSERT_EQUAL_UINT32(1, stats.live_nodes);
+  list_destroy(list, NULL);
+  while (!list_is_empty(snap)) {
+    TEST_ASSERT_NOT_NULL(list_remove(snap, 0));
+  }
+  TEST_ASSERT_TRUE(list_memory_stats(snap, &stats));
+  TEST_ASSERT_TRUE(stats.bytes <= stats.peak_bytes);
+  list_destroy(snap, NULL);
+}
+#else
+// MEMSTATS=off: the counters are compiled out and the query says so
+static void test_memory_stats_compiled_out(void) {
+  ListMemStats stats;
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(1)));
+  TEST_ASSERT_FALSE(list_memory_stats(list, &stats));
+  TEST_ASSERT_FALSE(list_memory_stats(NULL, &stats));
+  list_destroy(list, NULL);
+}
+#endif
+
+// --- Memory limits ---
+#ifndef LAB_NO_MEMORY_STATS
+static size_t evicted_count = 0;
+static void count_evicted(void *data) {
+  (void)data;
+  evicted_count++;
+}
+
+static void test_memory_limit_fails_fast(void) {
+  for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+    List *list = list_create(all_types[t]);
+    ListMemStats stats;
+    TEST_ASSERT_TRUE(list_memory_stats(list, &stats));
+    size_t limit = stats.bytes + 16 * 1024;
+    TEST_ASSERT_TRUE(list_set_memory_limit(list, limit, LIST_LIMIT_FAIL, NULL));
+    uintptr_t n = 0;
+    while (list_append(list, AS_PTR(n + 1))) {
+      n++;
+      TEST_ASSERT_TRUE(n < 1000000);
+    }
+    TEST_ASSERT_TRUE(n > 0);
+    TEST_ASSERT_EQUAL_UINT64(n, list_size(list)); // the failed append left no trace
+    TEST_ASSERT_TRUE(list_memory_stats(list, &stats));
+    TEST_ASSERT_TRUE(stats.peak_bytes <= limit);
+    for (uintptr_t i = 0; i < n; ++i) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(i + 1), list_get(list, i));
+    }
+
+    TEST_ASSERT_TRUE(list_set_memory_limit(list, 0, LIST_LIMIT_FAIL, NULL)); // lifted
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(n + 2)));
+    list_destroy(list, NULL);
+  }
+}
+
+static void test_memory_limit_evicts_from_head(void) {
+  for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+    List *list = list_create(all_types[t]);
+    ListMemStats stats;
+    TEST_ASSERT_TRUE(list_memory_stats(list, &stats));
+    size_t limit = stats.bytes + 16 * 1024;
+    TEST_ASSERT_TRUE(list_set_memory_limit(list, limit, LIST_LIMIT_EVICT_HEAD, count_evicted));
+    evicted_count = 0;
+    const uintptr_t total = 20000;
+    for (uintptr_t i = 0; i < total; ++i) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+    }
+    size_t size = list_size(list);
+    TEST_ASSERT_TRUE(size < total);
+    TEST_ASSERT_EQUAL_UINT64(total, size + evicted_count);
+    TEST_ASSERT_TRUE(list_memory_stats(list, &stats));
+    TEST_ASSERT_TRUE(stats.peak_bytes <= limit);
+    for (size_t i = 0; i < size; ++i) { // the newest elements survive, in order
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(total - size + i + 1), list_get(list, i));
+    }
+    list_destroy(list, NULL);
+  }
+}
+
+static void test_memory_limit_insert_and_guards(void) {
+  TEST_ASSERT_FALSE(list_set_memory_limit(NULL, 1024, LIST_LIMIT_FAIL, NULL));
+
+  // Evicting while inserting keeps the new element next to the same neighbour
+  ListOptions options = { .slab_nodes = 1 };
+  List *list = list_create_with_options(LIST_LINKED_SENTINEL, &options);
+  for (uintptr_t i = 0; i < 10; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  ListMemStats stats;
+  TEST_ASSERT_TRUE(list_memory_stats(list, &stats));
+  TEST_ASSERT_TRUE(list_set_memory_limit(list, stats.bytes, LIST_LIMIT_EVICT_HEAD, NULL));
+  TEST_ASSERT_TRUE(list_insert(list, 5, AS_PTR(100)));
+  TEST_ASSERT_EQUAL_UINT32(10, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(2), list_get(list, 0));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(100), list_get(list, 4));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(6), list_get(list, 5));
+
+  // A limit the first element cannot fit under empties the list and then fails
+  TEST_ASSERT_TRUE(list_set_memory_limit(list, 1, LIST_LIMIT_EVICT_HEAD, NULL));
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(200))); // reuses a free node
+  TEST_ASSERT_FALSE(list_compact(list)); // needs a new slab
+  list_destroy(list, NULL);
+
+  list = list_create(LIST_ARRAY);
+  TEST_ASSERT_TRUE(list_set_memory_limit(list, 1, LIST_LIMIT_EVICT_HEAD, NULL));
+  TEST_ASSERT_FALSE(list_append(list, AS_PTR(1)));
+  TEST_ASSERT_TRUE(list_is_empty(list));
+  list_destroy(list, NULL);
+}
+
+// A refusal left over from list_reserve must not make a later, unrelated
+// allocation failure evict
+static void test_memory_limit_ignores_stale_refusals(void) {
+  List *list = list_create(LIST_ARRAY);
+  for (uintptr_t i = 0; i < 8; ++i) { // fills the first buffer
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  ListMemStats stats;
+  TEST_ASSERT_TRUE(list_memory_stats(list, &stats));
+  TEST_ASSERT_TRUE(list_set_memory_limit(list, stats.bytes + 4096, LIST_LIMIT_EVICT_HEAD, NULL));
+  TEST_ASSERT_FALSE(list_reserve(list, 100000)); // refused by the limit
+
+  alloc_fail_after = 1; // the growth allocation itself fails
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_append(list, AS_PTR(9)));
+  alloc_fail_after = -1;
+  TEST_ASSERT_EQUAL_UINT32(8, list_size(list));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(1), list_get(list, 0));
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(9)));
+  list_destroy(list, NULL);
+}
+#else
+// MEMSTATS=off: limits are compiled out along with the counters
+static void test_memory_limit_compiled_out(void) {
+  List *list = list_create(LIST_ARRAY);
+  TEST_ASSERT_FALSE(list_set_memory_limit(list, 1, LIST_LIMIT_FAIL, NULL));
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(1)));
+  list_destroy(list, NULL);
+}
+#endif
+
+// --- Iterators ---
+static void test_iter_walks_both_ways(void) {
+  for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+    List *list = list_create(all_types[t]);
+    ListIter it;
+    TEST_ASSERT_FALSE(list_iter_begin(list, &it));
+    TEST_ASSERT_NULL(list_iter_get(&it));
+    TEST_ASSERT_FALSE(list_iter_next(&it));
+    TEST_ASSERT_FALSE(list_iter_prev(&it));
+    for (uintptr_t i = 0; i < 500; ++i) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+    }
+
+    uintptr_t expect = 1;
+    for (bool ok = list_iter_begin(list, &it); ok; ok = list_iter_next(&it)) {
+      TEST_ASSERT_EQUAL_UINT64(expect - 1, it.index);
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(expect), list_iter_get(&it));
+      expect++;
+    }
+    TEST_ASSERT_EQUAL_UINT64(501, expect);
+    TEST_ASSERT_NULL(list_iter_get(&it));
+
+    TEST_ASSERT_TRUE(list_iter_end(list, &it));
+    while (list_iter_prev(&it)) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(--expect), list_iter_get(&it));
+    }
+    TEST_ASSERT_EQUAL_UINT64(1, expect);
+    TEST_ASSERT_EQUAL_UINT64(0, it.index);
+    list_destroy(list, NULL);
+  }
+}
+
+// Moves a cursor around at random, inserting and removing through it, and
+// checks the list against a plain array.
+// Random cursor moves and edits on list, checked against an array model.
+static void iter_edits_against_model(List *list, unsigned seed) {
+  uintptr_t model[1024];
+  size_t n = 0;
+  uintptr_t next_val = 1;
+  ListIter it;
+  list_iter_begin(list, &it);
+  for (size_t step = 0; step < 20000; ++step) {
+    unsigned op = model_rand(&seed) % 6;
+    if (op == 0 && n < 1024) {
+      TEST_ASSERT_TRUE(list_iter_insert(&it, AS_PTR(next_val)));
+      for (size_t i = n; i > it.index - 1; --i) model[i] = model[i - 1];
+      model[it.index - 1] = next_val++;
+      n++;
+    } else if (op == 1) {
+      size_t at = it.index;
+      void *removed = list_iter_remove(&it);
+      if (at == n) {
+        TEST_ASSERT_NULL(removed);
+      } else {
+        TEST_ASSERT_EQUAL_PTR(AS_PTR(model[at]), removed);
+        for (size_t i = at; i + 1 < n; ++i) model[i] = model[i + 1];
+        n--;
+      }
+    } else if (op <= 3) {
+      bool has_next = it.index + 1 < n;
+      TEST_ASSERT_EQUAL(has_next, list_iter_next(&it));
+    } else {
+      (void)list_iter_prev(&it);
+    }
+    TEST_ASSERT_EQUAL_UINT64(n, list_size(list));
+    TEST_ASSERT_EQUAL_PTR(it.index < n ? AS_PTR(model[it.index]) : NULL, list_iter_get(&it));
+  }
+  for (size_t i = 0; i < n; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(model[i]), list_get(list, i));
+  }
+}
+
+static void test_iter_edits_against_model(void) {
+  for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+    List *list = list_create(all_types[t]);
+    iter_edits_against_model(list, 777u + (unsigned)t);
+    list_destroy(list, NULL);
+  }
+}
+
+// Tiny chunks make the unrolled cursor cross, split and merge chunks often
+static void test_iter_unrolled_chunk_edges(void) {
+  const size_t caps[] = { 2, 3 };
+  for (size_t c = 0; c < 2; ++c) {
+    ListOptions opts = { .chunk_capacity = caps[c] };
+    List *list = list_create_with_options(LIST_UNROLLED, &opts);
+    iter_edits_against_model(list, 4242u + (unsigned)c);
+    ListIter it;
+    size_t count = 0;
+    (void)list_iter_end(list, &it);
+    while (list_iter_prev(&it)) {
+      TEST_ASSERT_EQUAL_PTR(list_get(list, it.index), list_iter_get(&it));
+      count++;
+    }
+    TEST_ASSERT_EQUAL_UINT64(list_size(list), count);
+    list_destroy(list, NULL);
+  }
+}
+
+static void test_iter_sentinel_edits_and_guards(void) {
+  ListIter it;
+  TEST_ASSERT_FALSE(list_iter_begin(NULL, &it));
+  TEST_ASSERT_FALSE(list_iter_end(NULL, &it));
+  TEST_ASSERT_FALSE(list_iter_next(NULL));
+  TEST_ASSERT_FALSE(list_iter_prev(NULL));
+  TEST_ASSERT_NULL(list_iter_get(NULL));
+  TEST_ASSERT_FALSE(list_iter_insert(NULL, AS_PTR(1)));
+  TEST_ASSERT_NULL(list_iter_remove(NULL));
+
+  // Drop every odd element and double every even one in a single pass
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  TEST_ASSERT_FALSE(list_iter_begin(list, NULL));
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  TEST_ASSERT_TRUE(list_iter_begin(list, &it));
+  while (it.index < list_size(list)) {
+    uintptr_t v = (uintptr_t)list_iter_get(&it);
+    if (v % 2) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR(v), list_iter_remove(&it));
+    } else {
+      TEST_ASSERT_TRUE(list_iter_insert(&it, AS_PTR(v)));
+      (void)list_iter_next(&it);
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(1000, list_size(list));
+  for (size_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR((i / 2 + 1) * 2), list_get(list, i));
+  }
+
+  TEST_ASSERT_TRUE(list_compact(list)); // no spare nodes left
+  alloc_fail_after = 1; // so the insert needs a new slab
+  alloc_call_count = 0;
+  TEST_ASSERT_TRUE(list_iter_begin(list, &it));
+  TEST_ASSERT_FALSE(list_iter_insert(&it, AS_PTR(1)));
+  alloc_fail_after = -1;
+  TEST_ASSERT_EQUAL_UINT64(0, it.index);
+  TEST_ASSERT_EQUAL_UINT32(1000, list_size(list));
+  list_destroy(list, NULL);
+}
+
+// --- Batched gets ---
+static void test_get_many_matches_get(void) {
+  for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+    List *list = list_create(all_types[t]);
+    for (uintptr_t i = 0; i < 3000; ++i) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+    }
+    for (uintptr_t i = 0; i < 200; ++i) { // leave gaps and partly filled chunks
+      TEST_ASSERT_NOT_NULL(list_remove(list, (i * 37) % list_size(list)));
+    }
+    size_t n = list_size(list);
+    size_t idx[500];
+    void *out[500];
+    unsigned seed = 31u + (unsigned)t;
+    for (size_t i = 0; i < 500; ++i) {
+      idx[i] = i % 7 == 6 ? idx[i / 2] : (size_t)model_rand(&seed) * 7u % n; // repeats too
+    }
+    TEST_ASSERT_TRUE(list_get_many(list, idx, 500, out));
+    for (size_t i = 0; i < 500; ++i) {
+      TEST_ASSERT_EQUAL_PTR(list_get(list, idx[i]), out[i]);
+    }
+    for (size_t i = 0; i < 500; ++i) { // sorted input takes the no-scratch path
+      idx[i] = i * (n / 500);
+    }
+    TEST_ASSERT_TRUE(list_get_many(list, idx, 500, out));
+    for (size_t i = 0; i < 500; ++i) {
+      TEST_ASSERT_EQUAL_PTR(list_get(list, idx[i]), out[i]);
+    }
+    list_destroy(list, NULL);
+  }
+}
+
+static void test_get_many_guards_and_failure(void) {
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  size_t idx[3] = { 2, 0, 1 };
+  void *out[3] = { AS_PTR(9), AS_PTR(9), AS_PTR(9) };
+  TEST_ASSERT_FALSE(list_get_many(NULL, idx, 3, out));
+  TEST_ASSERT_TRUE(list_get_many(list, NULL, 0, NULL)); // nothing to do
+  TEST_ASSERT_FALSE(list_get_many(list, idx, 3, out)); // empty list: out of bounds
+  for (uintptr_t i = 0; i < 3; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  TEST_ASSERT_FALSE(list_get_many(list, NULL, 3, out));
+  TEST_ASSERT_FALSE(list_get_many(list, idx, 3, NULL));
+  idx[1] = 3;
+  TEST_ASSERT_FALSE(list_get_many(list, idx, 3, out));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(9), out[0]); // untouched
+  idx[1] = 0;
+
+  alloc_fail_after = 1; // the sort scratch
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_get_many(list, idx, 3, out));
+  alloc_fail_after = -1;
+  TEST_ASSERT_TRUE(list_get_many(list, idx, 3, out));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(3), out[0]);
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(1), out[1]);
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(2), out[2]);
+  list_destroy(list, NULL);
+}
+
+// --- Bulk traversal ---
+typedef struct CollectCtx {
+  void **items;
+  size_t count;
+  size_t stop_after; // 0: never stop
+} CollectCtx;
+
+static bool collect_item(void *data, void *ctx) {
+  CollectCtx *c = ctx;
+  c->items[c->count++] = data;
+  return c->stop_after == 0 || c->count < c->stop_after;
+}
+
+static void *add_step(void *data, void *ctx) {
+  return AS_PTR((uintptr_t)data + *(uintptr_t *)ctx);
+}
+
+static void *sum_items(void *acc, void *data, void *ctx) {
+  (void)ctx;
+  return AS_PTR((uintptr_t)acc + (uintptr_t)data);
+}
+
+static void test_bulk_ops_against_model(void) {
+  for (size_t t = 0; t < ALL_TYPES_COUNT; ++t) {
+    List *list = list_create(all_types[t]);
+    for (uintptr_t i = 0; i < 3000; ++i) {
+      TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+    }
+    for (uintptr_t i = 0; i < 200; ++i) { // leave gaps and partly filled chunks
+      TEST_ASSERT_NOT_NULL(list_remove(list, (i * 37) % list_size(list)));
+    }
+    size_t n = list_size(list);
+    void **items = malloc(n * sizeof(void *));
+    uintptr_t sum = 0;
+    for (size_t i = 0; i < n; ++i) sum += (uintptr_t)list_get(list, i);
+
+    CollectCtx c = { items, 0, 0 };
+    TEST_ASSERT_EQUAL_UINT32(n, list_foreach(list, collect_item, &c));
+    for (size_t i = 0; i < n; ++i) {
+      TEST_ASSERT_EQUAL_PTR(list_get(list, i), items[i]);
+    }
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(sum + 5), list_reduce(list, sum_items, AS_PTR(5), NULL));
+
+    uintptr_t step = 10000;
+    TEST_ASSERT_TRUE(list_map_inplace(list, add_step, &step));
+    TEST_ASSERT_EQUAL_UINT32(n, list_size(list));
+    for (size_t i = 0; i < n; ++i) {
+      TEST_ASSERT_EQUAL_PTR(AS_PTR((uintptr_t)items[i] + step), list_get(list, i));
+    }
+
+    c = (CollectCtx){ items, 0, 17 }; // stops on the 17th element
+    TEST_ASSERT_EQUAL_UINT32(17, list_foreach(list, collect_item, &c));
+    TEST_ASSERT_EQUAL_PTR(list_get(list, 16), items[16]);
+    free(items);
+    list_destroy(list, NULL);
+  }
+}
+
+static void test_map_copies_shared_btree_nodes(void) {
+  List *list = list_create(LIST_BTREE);
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  List *snap = list_snapshot(list);
+  uintptr_t step = 1;
+  alloc_fail_after = 2; // root copied, first shared leaf copy fails
+  alloc_call_count = 0;
+  TEST_ASSERT_FALSE(list_map_inplace(list, add_step, &step));
+  alloc_fail_after = -1;
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(1), list_get(list, 0)); // nothing mapped
+  TEST_ASSERT_TRUE(list_map_inplace(list, add_step, &step));
+  for (uintptr_t i = 0; i < 1000; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i + 2), list_get(list, i));
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i + 1), list_get(snap, i));
+  }
+  list_destroy(snap, NULL);
+  list_destroy(list, NULL);
+}
+
+static void test_bulk_ops_guards(void) {
+  List *list = list_create(LIST_LINKED_SENTINEL);
+  uintptr_t step = 1;
+  TEST_ASSERT_EQUAL_UINT32(0, list_foreach(NULL, collect_item, NULL));
+  TEST_ASSERT_EQUAL_UINT32(0, list_foreach(list, NULL, NULL));
+  TEST_ASSERT_FALSE(list_map_inplace(NULL, add_step, &step));
+  TEST_ASSERT_FALSE(list_map_inplace(list, NULL, NULL));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(7), list_reduce(NULL, sum_items, AS_PTR(7), NULL));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(7), list_reduce(list, NULL, AS_PTR(7), NULL));
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(7), list_reduce(list, sum_items, AS_PTR(7), NULL)); // empty
+  TEST_ASSERT_TRUE(list_map_inplace(list, add_step, &step));
+  list_destroy(list, NULL);
+}
+
+// --- LIST_ADAPTIVE ---
+static void test_adaptive_switches_with_the_mix(void) {
+  List *list = list_create(LIST_ADAPTIVE);
+  ListAdaptiveStats stats;
+  for (uintptr_t i = 0; i < 2000; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  TEST_ASSERT_TRUE(list_adaptive_stats(list, &stats));
+  TEST_ASSERT_EQUAL_INT(LIST_ARRAY, stats.layout);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.migrations);
+
+  // Queue traffic at the head favours the linked layout
+  for (uintptr_t i = 0; i < 2000; ++i) {
+    TEST_ASSERT_TRUE(list_insert(list, 0, AS_PTR(5000 + i)));
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(5000 + i), list_remove(list, 0));
+  }
+  TEST_ASSERT_TRUE(list_adaptive_stats(list, &stats));
+  TEST_ASSERT_EQUAL_INT(LIST_LINKED_SENTINEL, stats.layout);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.to_linked);
+
+  // Random reads favour the array layout again
+  unsigned seed = 3;
+  for (int i = 0; i < 1000; ++i) {
+    size_t idx = (size_t)model_rand(&seed) % 2000;
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(idx + 1), list_get(list, idx));
+  }
+  TEST_ASSERT_TRUE(list_adaptive_stats(list, &stats));
+  TEST_ASSERT_EQUAL_INT(LIST_ARRAY, stats.layout);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.to_array);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.migrations);
+  TEST_ASSERT_EQUAL_UINT32(2000, stats.appends);
+  TEST_ASSERT_EQUAL_UINT32(2000, stats.inserts);
+  TEST_ASSERT_EQUAL_UINT32(2000, stats.removes);
+  TEST_ASSERT_EQUAL_UINT32(1000, stats.gets);
+
+  for (uintptr_t i = 0; i < 2000; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(i + 1), list_get(list, i));
+  }
+  free_count = 0;
+  list_destroy(list, dummy_free);
+  TEST_ASSERT_EQUAL_INT(2000, free_count);
+}
+
+// A migration triggered by the append that closes a window must copy every
+// element, in both directions.
+static void test_adaptive_migrates_on_append(void) {
+  List *list = list_create(LIST_ADAPTIVE);
+  ListAdaptiveStats stats;
+  uintptr_t model[2100];
+  size_t n = 0;
+  for (uintptr_t i = 0; i < 2048; ++i) { // exactly eight windows of appends
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+    model[n++] = i + 1;
+  }
+
+  // 255 front edits, then the append that ends the window moves to linked
+  for (uintptr_t i = 0; i < 127; ++i) {
+    TEST_ASSERT_TRUE(list_insert(list, 0, AS_PTR(9000 + i)));
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(9000 + i), list_remove(list, 0));
+  }
+  TEST_ASSERT_EQUAL_PTR(AS_PTR(1), list_remove(list, 0));
+  for (size_t j = 0; j + 1 < n; ++j) model[j] = model[j + 1];
+  n--;
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(7001)));
+  model[n++] = 7001;
+  TEST_ASSERT_TRUE(list_adaptive_stats(list, &stats));
+  TEST_ASSERT_EQUAL_INT(LIST_LINKED_SENTINEL, stats.layout);
+  TEST_ASSERT_EQUAL_UINT32(2048, list_size(list));
+
+  // 255 reads, then the append that ends the window moves back to the array;
+  // 2048 is a power of two, so a short copy count would overflow the buffer
+  for (size_t i = 0; i < 255; ++i) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(model[i * 8]), list_get(list, i * 8));
+  }
+  TEST_ASSERT_TRUE(list_append(list, AS_PTR(7002)));
+  model[n++] = 7002;
+  TEST_ASSERT_TRUE(list_adaptive_stats(list, &stats));
+  TEST_ASSERT_EQUAL_INT(LIST_ARRAY, stats.layout);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.to_linked);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.to_array);
+
+  TEST_ASSERT_EQUAL_UINT32(n, list_size(list));
+  for (size_t j = 0; j < n; ++j) {
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(model[j]), list_get(list, j));
+  }
+  list_destroy(list, NULL);
+}
+
+// The linked layout a migration builds keeps the options the list was created with
+static void test_adaptive_migration_keeps_options(void) {
+  ListOptions opts = { .slab_nodes = 1 }; // one allocation per node
+  List *list = list_create_with_options(LIST_ADAPTIVE, &opts);
+  ListAdaptiveStats stats;
+  for (uintptr_t i = 0; i < 2000; ++i) {
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(i + 1)));
+  }
+  for (uintptr_t i = 0; i < 2000; ++i) { // head traffic: moves to linked
+    TEST_ASSERT_TRUE(list_insert(list, 0, AS_PTR(5000 + i)));
+    TEST_ASSERT_EQUAL_PTR(AS_PTR(5000 + i), list_remove(list, 0));
+  }
+  TEST_ASSERT_TRUE(list_adaptive_stats(list, &stats));
+  TEST_ASSERT_EQUAL_INT(LIST_LINKED_SENTINEL, stats.layout);
+
+  alloc_call_count = 0;
+  for (uintptr_t i = 0; i < 100; ++i) { // tail traffic keeps the layout
+    TEST_ASSERT_TRUE(list_append(list, AS_PTR(9000 + i)));
+  }
+  TEST_ASSERT_TRUE(list_adaptive_stats(list, &stats));
+  TEST_ASSERT_EQUAL_INT(LIST_LINKED_SENTINEL, stats.layout);
+  TEST_ASSERT_TRUE(alloc_call_count >= 99); // at most the one spare node is reused
+  list_destroy(list, NULL);
+}
+
+static void test_adaptive_stats_guards(void) {
+  ListAdaptiveStats stats;
+  List *list = list_create(LIST_ARRAY);
+  TEST_ASSERT_FALSE(list_adaptive_stats(list, &stats));
+  TEST_ASSERT_FALSE(list_adaptive_stats(NULL, &stats));
+  list_destroy(list, NULL);
+  list = list_create(LIST_ADAPTIVE);
+  TEST_ASSERT_FALSE(list_adaptive_stats(list, NULL));
+  list_destroy(list, NULL);
+}
+
 int main(void) {
   UNITY_BEGIN();
   RUN_TEST(test_create_and_destroy);
@@ -217,5 +2028,74 @@ int main(void) {
   RUN_TEST(test_get_last_index_and_oob);
   RUN_TEST(test_insert_head_tail_and_remove_to_empty);
   RUN_TEST(test_null_list_guards);
+  RUN_TEST(test_all_types_basic);
+  RUN_TEST(test_all_types_against_model);
+  RUN_TEST(test_create_unknown_type);
+  RUN_TEST(test_array_grow_and_shrink);
+  RUN_TEST(test_array_alloc_failure);
+  RUN_TEST(test_unrolled_small_chunks_against_model);
+  RUN_TEST(test_unrolled_alloc_failure);
+  RUN_TEST(test_tree_large_sequential);
+  RUN_TEST(test_tree_alloc_failure);
+  RUN_TEST(test_skip_seeds_against_model);
+  RUN_TEST(test_skip_alloc_failure);
+  RUN_TEST(test_ring_queue_is_allocation_free);
+  RUN_TEST(test_ring_grow_while_wrapped);
+  RUN_TEST(test_btree_multi_level_against_model);
+  RUN_TEST(test_btree_append_then_drain);
+  RUN_TEST(test_btree_split_alloc_failure);
+  RUN_TEST(test_gap_cursor_edits);
+  RUN_TEST(test_gap_grow_alloc_failure);
+  RUN_TEST(test_tiered_grow_and_shrink_tiers);
+  RUN_TEST(test_tiered_alloc_failure);
+  RUN_TEST(test_snapshot_is_isolated);
+  RUN_TEST(test_snapshot_chain_against_copies);
+  RUN_TEST(test_snapshot_copy_on_write_alloc_failure);
+  RUN_TEST(test_snapshot_unsupported_types);
+  RUN_TEST(test_sentinel_slabs_recycle_nodes);
+  RUN_TEST(test_sentinel_slab_alloc_failure);
+  RUN_TEST(test_sentinel_finger_seeks);
+  RUN_TEST(test_sentinel_index_against_model);
+  RUN_TEST(test_sentinel_index_memory_and_guards);
+  RUN_TEST(test_allocator_is_per_list);
+  RUN_TEST(test_allocator_failure_and_guards);
+  RUN_TEST(test_arena_lists_allocate_in_chunks);
+  RUN_TEST(test_arena_free_func_and_failures);
+  RUN_TEST(test_node_cache_recycles_nodes);
+  RUN_TEST(test_node_cache_fills_whole_magazines);
+  RUN_TEST(test_node_cache_across_threads);
+  RUN_TEST(test_reserve_makes_appends_allocation_free);
+  RUN_TEST(test_reserve_sentinel_pool_and_guards);
+  RUN_TEST(test_compact_keeps_order);
+  RUN_TEST(test_compact_failure_and_unsupported);
+  RUN_TEST(test_region_pool_backs_every_type);
+  RUN_TEST(test_region_pool_guards);
+#ifndef LAB_NO_MEMORY_STATS
+  RUN_TEST(test_memory_stats_track_the_allocator);
+  RUN_TEST(test_memory_stats_thread_cache_and_guards);
+#else
+  RUN_TEST(test_memory_stats_compiled_out);
+#endif
+#ifndef LAB_NO_MEMORY_STATS
+  RUN_TEST(test_memory_limit_fails_fast);
+  RUN_TEST(test_memory_limit_evicts_from_head);
+  RUN_TEST(test_memory_limit_insert_and_guards);
+  RUN_TEST(test_memory_limit_ignores_stale_refusals);
+#else
+  RUN_TEST(test_memory_limit_compiled_out);
+#endif
+  RUN_TEST(test_iter_walks_both_ways);
+  RUN_TEST(test_iter_edits_against_model);
+  RUN_TEST(test_iter_unrolled_chunk_edges);
+  RUN_TEST(test_iter_sentinel_edits_and_guards);
+  RUN_TEST(test_get_many_matches_get);
+  RUN_TEST(test_get_many_guards_and_failure);
+  RUN_TEST(test_bulk_ops_against_model);
+  RUN_TEST(test_map_copies_shared_btree_nodes);
+  RUN_TEST(test_bulk_ops_guards);
+  RUN_TEST(test_adaptive_switches_with_the_mix);
+  RUN_TEST(test_adaptive_migrates_on_append);
+  RUN_TEST(test_adaptive_migration_keeps_options);
+  RUN_TEST(test_adaptive_stats_guards);
   return UNITY_END();
 }